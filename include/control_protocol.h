@@ -0,0 +1,58 @@
+#ifndef CONTROL_PROTOCOL_H
+#define CONTROL_PROTOCOL_H
+
+#include <stdint.h>
+
+// Joystick frame pushed by the driving page on the /ws WebSocket (binary frame).
+// Little-endian, 8 bytes. The page only sends when the stick moves, the car
+// keeps driving the last frame received.
+typedef struct __attribute__((packed)) {
+    uint16_t seq;       // Incremented on every frame, older frames are dropped
+    int8_t x;           // Steering, -100 (left) to 100 (right)
+    int8_t y;           // Throttle, -100 (backward) to 100 (forward)
+    uint32_t client_ms; // Page clock synced on /time, in ms (device clock, low 32 bits)
+} joy_frame_t;
+
+// True when seq comes after last, modulo 2^16
+static inline bool joy_seq_newer(uint16_t seq, uint16_t last) {
+    return (int16_t)(uint16_t)(seq - last) > 0;
+}
+
+// UDP control port (UDP_CONTROL_PORT), for scripted driving. Shared with tools/udp_drive.cpp.
+// Little-endian like the ESP32 and x86 hosts, one command per datagram.
+#define UDP_CMD_MAGIC 0x4352       // "RC"
+#define UDP_TELEMETRY_MAGIC 0x5443 // "CT"
+
+#define UDP_FLAG_STOP 0x01   // Stop the motors, x and y are ignored
+#define UDP_FLAG_SYNCED 0x02 // client_ms is in the device clock, packets too old are dropped
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;     // UDP_CMD_MAGIC
+    int8_t x;           // Steering, -100 (left) to 100 (right)
+    int8_t y;           // Throttle, -100 (backward) to 100 (forward)
+    uint32_t seq;       // Incremented on every packet, older packets are dropped
+    uint8_t flags;      // UDP_FLAG_*
+    uint8_t reserved[3];
+    uint32_t client_ms; // Send time, device clock once synced from the telemetry replies
+} udp_cmd_t;
+
+// Reply to every accepted command
+typedef struct __attribute__((packed)) {
+    uint16_t magic;     // UDP_TELEMETRY_MAGIC
+    uint8_t battery;    // Battery percentage
+    uint8_t flags;      // Flags of the command
+    uint32_t seq;       // Command acknowledged
+    uint32_t client_ms; // Echo of the command, for the round trip time
+    uint32_t device_ms; // Device clock when the command was applied
+    int8_t duty_right;  // Motor duty cycles applied, -100 to 100
+    int8_t duty_left;
+    uint16_t fps_x10;   // Camera frame rate x10
+    uint32_t dropped;   // Packets ignored so far (malformed, out of order or stale)
+} udp_telemetry_t;
+
+// True when seq comes after last, modulo 2^32
+static inline bool udp_seq_newer(uint32_t seq, uint32_t last) {
+    return (int32_t)(seq - last) > 0;
+}
+
+#endif // CONTROL_PROTOCOL_H
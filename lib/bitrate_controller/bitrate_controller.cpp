@@ -0,0 +1,87 @@
+#include "bitrate_controller.h"
+
+static int abr_quality_levels(const abr_config_t *config){
+    return (config->max_quality - config->min_quality) / config->quality_step + 1;
+}
+
+static int abr_max_level(const abr_config_t *config, const abr_state_t *state){
+    return (config->framesize_count - state->top) * abr_quality_levels(config) - 1;
+}
+
+// Anchor the ladder on the framesize and quality picked by the user
+void abr_reset(const abr_config_t *config, abr_state_t *state, int framesize, int quality){
+    state->top = config->framesize_count - 1;
+    for (int i = 0; i < config->framesize_count; i++){
+        if (config->framesizes[i] <= framesize){
+            state->top = i;
+            break;
+        }
+    }
+    if (quality < config->min_quality) quality = config->min_quality;
+    if (quality > config->max_quality) quality = config->max_quality;
+    state->level = (quality - config->min_quality) / config->quality_step;
+    state->degrade_count = 0;
+    state->improve_count = 0;
+}
+
+void abr_sample(abr_window_t *window, size_t frame_len, uint32_t send_us){
+    window->frames++;
+    window->bytes += frame_len;
+    window->send_us += send_us;
+}
+
+abr_vote_t abr_evaluate(const abr_config_t *config, abr_window_t *window, uint32_t elapsed_us){
+    abr_vote_t vote = ABR_HOLD;
+
+    if (config->target_fps > 0 && elapsed_us && window->frames){
+        float send_per_frame = (float)window->send_us / window->frames;
+        float load = send_per_frame * config->target_fps / 1000000.0f;
+        if (config->max_frame_bytes){
+            float byte_load = (float)window->bytes / window->frames / config->max_frame_bytes;
+            if (byte_load > load) load = byte_load;
+        }
+        if (load > config->degrade_load){
+            vote = ABR_DEGRADE;
+        } else if (load < config->improve_load){
+            vote = ABR_IMPROVE;
+        }
+    }
+
+    window->frames = 0;
+    window->bytes = 0;
+    window->send_us = 0;
+    return vote;
+}
+
+// Hysteresis: only move after enough consecutive windows agree
+bool abr_step(const abr_config_t *config, abr_state_t *state, abr_vote_t vote){
+    if (vote == ABR_DEGRADE){
+        state->improve_count = 0;
+        if (++state->degrade_count < config->degrade_windows || state->level >= abr_max_level(config, state)){
+            return false;
+        }
+        state->degrade_count = 0;
+        state->level++;
+        return true;
+    }
+    if (vote == ABR_IMPROVE){
+        state->degrade_count = 0;
+        if (++state->improve_count < config->improve_windows || state->level <= 0){
+            return false;
+        }
+        state->improve_count = 0;
+        state->level--;
+        return true;
+    }
+    state->degrade_count = 0;
+    state->improve_count = 0;
+    return false;
+}
+
+int abr_quality(const abr_config_t *config, const abr_state_t *state){
+    return config->min_quality + (state->level % abr_quality_levels(config)) * config->quality_step;
+}
+
+int abr_framesize(const abr_config_t *config, const abr_state_t *state){
+    return config->framesizes[state->top + state->level / abr_quality_levels(config)];
+}
@@ -0,0 +1,61 @@
+#ifndef BITRATE_CONTROLLER_H
+#define BITRATE_CONTROLLER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Closed-loop stream quality controller.
+// No camera or network dependency so the control law can be run on the host.
+//
+// The controller walks a ladder of levels, best first: every JPEG quality of
+// the largest framesize, then every quality of the next framesize, and so on.
+// Load is the share of the frame interval (at the target FPS) spent sending
+// a frame, so a load above 1 means the link cannot carry the target rate.
+// With a byte budget, the mean frame size over the budget is a load too and
+// the larger of the two decides.
+
+#define ABR_MAX_FRAMESIZES 8
+
+typedef struct {
+    float target_fps;         // 0 disables the controller
+    uint32_t max_frame_bytes; // Byte budget per frame, 0 for none
+    int min_quality;          // Best JPEG quality (lowest value)
+    int max_quality;          // Worst JPEG quality allowed
+    int quality_step;
+    int framesizes[ABR_MAX_FRAMESIZES]; // Framesizes, largest first
+    int framesize_count;
+    float degrade_load;       // Step down above this load
+    float improve_load;       // Step up below this load
+    int degrade_windows;      // Consecutive windows before stepping down
+    int improve_windows;      // Consecutive windows before stepping up
+} abr_config_t;
+
+// Measurements of one stream over one window
+typedef struct {
+    uint32_t frames;
+    uint64_t bytes;
+    uint64_t send_us;
+} abr_window_t;
+
+typedef struct {
+    int top;                  // Index of the largest framesize allowed
+    int level;                // Position on the ladder, 0 = best
+    int degrade_count;
+    int improve_count;
+} abr_state_t;
+
+// Vote of a window: step down, hold or step up
+typedef enum {
+    ABR_DEGRADE = -1,
+    ABR_HOLD = 0,
+    ABR_IMPROVE = 1,
+} abr_vote_t;
+
+void abr_reset(const abr_config_t *config, abr_state_t *state, int framesize, int quality);
+void abr_sample(abr_window_t *window, size_t frame_len, uint32_t send_us);
+abr_vote_t abr_evaluate(const abr_config_t *config, abr_window_t *window, uint32_t elapsed_us);
+bool abr_step(const abr_config_t *config, abr_state_t *state, abr_vote_t vote);
+int abr_quality(const abr_config_t *config, const abr_state_t *state);
+int abr_framesize(const abr_config_t *config, const abr_state_t *state);
+
+#endif // BITRATE_CONTROLLER_H
@@ -0,0 +1,43 @@
+#include "camera_roi.h"
+#include <stdio.h>
+
+static int roi_clamp(int value, int low, int high){
+    return value < low ? low : (value > high ? high : value);
+}
+
+roi_window_t roi_window(const camera_roi_t *roi, int sensor_w, int sensor_h, int out_w, int out_h, int align){
+    roi_window_t win;
+    int zoom = roi->zoom < 100 ? 100 : roi->zoom;
+
+    win.width = sensor_w * 100 / zoom / align * align;
+    if (win.width < out_w){
+        win.width = (out_w + align - 1) / align * align;
+    }
+    win.height = win.width * sensor_h / sensor_w / align * align;
+    if (win.height < out_h){
+        win.height = (out_h + align - 1) / align * align;
+    }
+    if (win.width > sensor_w) win.width = sensor_w;
+    if (win.height > sensor_h) win.height = sensor_h;
+
+    int cx = roi_clamp(roi->center_x, 0, 1000) * sensor_w / 1000;
+    int cy = roi_clamp(roi->center_y, 0, 1000) * sensor_h / 1000;
+    win.x = roi_clamp(cx - win.width / 2, 0, sensor_w - win.width) & ~1;
+    win.y = roi_clamp(cy - win.height / 2, 0, sensor_h - win.height) & ~1;
+    return win;
+}
+
+bool roi_parse(const char *str, camera_roi_t *roi){
+    camera_roi_t parsed = {100, 500, 500};
+    int count = sscanf(str, "%d,%d,%d", &parsed.zoom, &parsed.center_x, &parsed.center_y);
+    if (count != 1 && count != 3){
+        return false;
+    }
+    if (parsed.zoom < 100 || parsed.zoom > 800){
+        return false;
+    }
+    parsed.center_x = roi_clamp(parsed.center_x, 0, 1000);
+    parsed.center_y = roi_clamp(parsed.center_y, 0, 1000);
+    *roi = parsed;
+    return true;
+}
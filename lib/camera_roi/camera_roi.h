@@ -0,0 +1,28 @@
+#ifndef CAMERA_ROI_H
+#define CAMERA_ROI_H
+
+// Region of interest on the sensor array, used for digital zoom and pan.
+// Pure geometry, the sensor specific register mapping lives with the caller.
+
+typedef struct {
+    int zoom;     // Percent, 100 = full field of view
+    int center_x; // Permille of the sensor width
+    int center_y; // Permille of the sensor height
+} camera_roi_t;
+
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} roi_window_t;
+
+// Window of a sensor_w x sensor_h array matching the ROI.
+// The window keeps the sensor aspect ratio, is a multiple of align, never
+// smaller than the output (sensors only scale down) and stays on the array.
+roi_window_t roi_window(const camera_roi_t *roi, int sensor_w, int sensor_h, int out_w, int out_h, int align);
+
+// Parse "zoom,center_x,center_y" (center defaults to the middle), false if invalid
+bool roi_parse(const char *str, camera_roi_t *roi);
+
+#endif // CAMERA_ROI_H
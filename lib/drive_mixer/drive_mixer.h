@@ -0,0 +1,81 @@
+#ifndef DRIVE_MIXER_H
+#define DRIVE_MIXER_H
+
+#include <stdint.h>
+
+// Differential drive mixer: joystick (x steering, y throttle, -100..100) to
+// right/left duty cycles (-100..100). Integer arithmetic only, header-only so
+// the same code runs in the motor task and on the host.
+//
+// Turn factor: the throttle is scaled down while steering,
+// 1 - turn_drop * (x / 100)^2, never below turn_min. Units of 1/10000 keep the
+// factor exact for every stick position, so the results match the real
+// arithmetic the float mixer approximated.
+
+#define DRIVE_TURN_ONE 10000 // Turn factor 1.0
+#define DRIVE_AXIS_MAX 100   // Joystick and duty cycle range
+
+typedef struct {
+    int deadband;          // Both axes below this stop the motors
+    int reverse_threshold; // Throttle below -this mirrors the steering when backing up
+    int steer_weight;      // Share of the steering given to each motor, 1/256 (128 = 0.5)
+    int turn_drop;         // Turn factor drop at full steering, 1/10000
+    int turn_min;          // Lowest turn factor, 1/10000
+} drive_mixer_config_t;
+
+// Handling of the original float mixer: deadband 10, half the steering on
+// each side, 1 - (x / 100)^2 clamped to 0.9
+constexpr drive_mixer_config_t DRIVE_MIXER_DEFAULT = { 10, 10, 128, 10000, 9000 };
+
+// Turn factor for a steering magnitude of ax (0..100), 1/10000
+constexpr int drive_turn_factor(const drive_mixer_config_t &config, int ax) {
+    return DRIVE_TURN_ONE - config.turn_drop * ax * ax / (DRIVE_AXIS_MAX * DRIVE_AXIS_MAX) < config.turn_min
+        ? config.turn_min
+        : DRIVE_TURN_ONE - config.turn_drop * ax * ax / (DRIVE_AXIS_MAX * DRIVE_AXIS_MAX);
+}
+
+// Precomputed turn factors for ax = 0..100, built at compile time:
+//   DRIVE_TURN_LUT(turn_lut, config);
+// where config is a constexpr drive_mixer_config_t. Worth it for curves
+// costlier than the quadratic, or to hand tune single entries.
+#define DRIVE_TURN_LUT_10(config, i) \
+    drive_turn_factor(config, i), drive_turn_factor(config, i + 1), drive_turn_factor(config, i + 2), \
+    drive_turn_factor(config, i + 3), drive_turn_factor(config, i + 4), drive_turn_factor(config, i + 5), \
+    drive_turn_factor(config, i + 6), drive_turn_factor(config, i + 7), drive_turn_factor(config, i + 8), \
+    drive_turn_factor(config, i + 9)
+#define DRIVE_TURN_LUT(name, config) \
+    static constexpr uint16_t name[DRIVE_AXIS_MAX + 1] = { \
+        DRIVE_TURN_LUT_10(config, 0), DRIVE_TURN_LUT_10(config, 10), DRIVE_TURN_LUT_10(config, 20), \
+        DRIVE_TURN_LUT_10(config, 30), DRIVE_TURN_LUT_10(config, 40), DRIVE_TURN_LUT_10(config, 50), \
+        DRIVE_TURN_LUT_10(config, 60), DRIVE_TURN_LUT_10(config, 70), DRIVE_TURN_LUT_10(config, 80), \
+        DRIVE_TURN_LUT_10(config, 90), drive_turn_factor(config, 100) }
+
+static inline int drive_clamp(int v, int lo, int hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// Mix x and y into the right and left duty cycles. turn_lut is optional,
+// built with DRIVE_TURN_LUT for the same config.
+// Divisions truncate toward zero like the float to int conversions they replace.
+static inline void drive_mix(const drive_mixer_config_t &config, int x, int y, int *right, int *left,
+                             const uint16_t *turn_lut = nullptr) {
+    x = drive_clamp(x, -DRIVE_AXIS_MAX, DRIVE_AXIS_MAX);
+    y = drive_clamp(y, -DRIVE_AXIS_MAX, DRIVE_AXIS_MAX);
+    int ax = x < 0 ? -x : x;
+    int ay = y < 0 ? -y : y;
+    if (ax < config.deadband && ay < config.deadband) {
+        *right = 0;
+        *left = 0;
+        return;
+    }
+
+    int turn = turn_lut ? turn_lut[ax] : drive_turn_factor(config, ax);
+    int steer = (y < -config.reverse_threshold ? -x : x) * config.steer_weight; // Mirrored when backing up
+
+    int duty_right = (y * 256 - steer) / 256 * turn / DRIVE_TURN_ONE;
+    int duty_left = (y * 256 + steer) / 256 * turn / DRIVE_TURN_ONE;
+    *right = drive_clamp(duty_right, -DRIVE_AXIS_MAX, DRIVE_AXIS_MAX);
+    *left = drive_clamp(duty_left, -DRIVE_AXIS_MAX, DRIVE_AXIS_MAX);
+}
+
+#endif // DRIVE_MIXER_H
@@ -0,0 +1,409 @@
+#include "jpeg_dc.h"
+#include <string.h>
+
+#define JPEG_DC_COMPONENTS 4
+
+typedef struct {
+    uint8_t id;
+    uint8_t h;        // Sampling factors
+    uint8_t v;
+    uint8_t quant;    // Quantization table
+    uint8_t dc_table; // Huffman tables, set by SOS
+    uint8_t ac_table;
+    int pred;         // DC predictor
+} jpeg_dc_component_t;
+
+// Entropy coded data reader, bits are kept MSB first
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    uint32_t bits;
+    int count;
+    bool marker;      // Stopped in front of a marker, zeros are fed from there
+} jpeg_dc_reader_t;
+
+static uint16_t read_u16(const uint8_t *p){
+    return (p[0] << 8) | p[1];
+}
+
+static void reader_fill(jpeg_dc_reader_t *r){
+    while (r->count <= 24){
+        if (r->p < r->end && *r->p != 0xFF){
+            r->bits |= (uint32_t)*r->p++ << (24 - r->count);
+            r->count += 8;
+            continue;
+        }
+        uint32_t byte = 0;
+        if (!r->marker && r->p < r->end){
+            byte = *r->p++;
+            if (byte == 0xFF){
+                if (r->p < r->end && *r->p == 0x00){
+                    r->p++; // Stuffed zero
+                } else {
+                    r->marker = true;
+                    r->p--;
+                    byte = 0;
+                }
+            }
+        }
+        r->bits |= byte << (24 - r->count);
+        r->count += 8;
+    }
+}
+
+static int reader_bits(jpeg_dc_reader_t *r, int n){
+    reader_fill(r);
+    int v = r->bits >> (32 - n);
+    r->bits <<= n;
+    r->count -= n;
+    return v;
+}
+
+// Value of an s bit coefficient (F.2.2.1 EXTEND)
+static int reader_extend(jpeg_dc_reader_t *r, int s){
+    if (!s){
+        return 0;
+    }
+    int v = reader_bits(r, s);
+    return v < (1 << (s - 1)) ? v - (1 << s) + 1 : v;
+}
+
+static void reader_skip(jpeg_dc_reader_t *r, int s){
+    if (s){
+        reader_fill(r);
+        r->bits <<= s;
+        r->count -= s;
+    }
+}
+
+// Next Huffman symbol, -1 on an invalid code
+static int reader_decode(jpeg_dc_reader_t *r, const jpeg_dc_huffman_t *h){
+    reader_fill(r);
+    int prefix = r->bits >> 24;
+    int len = h->lookup_len[prefix];
+    if (len){
+        r->bits <<= len;
+        r->count -= len;
+        return h->lookup_symbol[prefix];
+    }
+    for (len = 9; len <= 16; len++){
+        int32_t code = r->bits >> (32 - len);
+        if (code <= h->maxcode[len]){
+            r->bits <<= len;
+            r->count -= len;
+            return h->symbols[(h->offset[len] + code) & 0xFF];
+        }
+    }
+    return -1;
+}
+
+// Skip the restart marker at the end of an interval and start a new one
+static bool reader_restart(jpeg_dc_reader_t *r){
+    r->bits = 0;
+    r->count = 0;
+    r->marker = false;
+    while (r->p + 1 < r->end && !(r->p[0] == 0xFF && r->p[1] >= 0xD0 && r->p[1] <= 0xD7)){
+        r->p++;
+    }
+    if (r->p + 1 >= r->end){
+        return false;
+    }
+    r->p += 2;
+    return true;
+}
+
+static bool parse_dht(jpeg_dc_decoder_t *decoder, const uint8_t *p, size_t len){
+    const uint8_t *end = p + len;
+    while (p < end){
+        if (end - p < 17){
+            return false;
+        }
+        int table_class = p[0] >> 4;
+        int id = p[0] & 0x0F;
+        if (table_class > 1 || id >= JPEG_DC_TABLES){
+            return false;
+        }
+        const uint8_t *counts = p + 1;
+        int total = 0;
+        for (int i = 0; i < 16; i++){
+            total += counts[i];
+        }
+        p += 17;
+        if (total > 256 || end - p < total){
+            return false;
+        }
+
+        jpeg_dc_huffman_t *h = table_class ? &decoder->ac[id] : &decoder->dc[id];
+        memset(h->lookup_len, 0, sizeof(h->lookup_len));
+        memset(h->lookup_ac, 0, sizeof(h->lookup_ac));
+        memcpy(h->symbols, p, total);
+        // Canonical codes, short ones also go in the 8 bit lookup table
+        int32_t code = 0;
+        int k = 0;
+        for (int len = 1; len <= 16; len++){
+            h->offset[len] = k - code;
+            for (int i = 0; i < counts[len - 1]; i++, code++, k++){
+                if (code >= (1 << len)){
+                    return false; // Over-subscribed table
+                }
+                if (len <= 8){
+                    int first = code << (8 - len);
+                    int rs = h->symbols[k];
+                    int bits = len + (rs & 0x0F);
+                    int advance = (rs & 0x0F) ? (rs >> 4) + 1 : (rs == 0xF0 ? 16 : 64);
+                    for (int j = 0; j < (1 << (8 - len)); j++){
+                        h->lookup_len[first + j] = len;
+                        h->lookup_symbol[first + j] = rs;
+                        h->lookup_ac[first + j] = bits <= 8 ? (advance << 8) | bits : 0;
+                    }
+                }
+            }
+            h->maxcode[len] = counts[len - 1] ? code - 1 : -1;
+            code <<= 1;
+        }
+        h->defined = true;
+        p += total;
+    }
+    return true;
+}
+
+static bool parse_dqt(jpeg_dc_decoder_t *decoder, const uint8_t *p, size_t len){
+    const uint8_t *end = p + len;
+    while (p < end){
+        int precision = p[0] >> 4;
+        int id = p[0] & 0x0F;
+        size_t size = 1 + 64 * (precision + 1);
+        if (id > 3 || (size_t)(end - p) < size){
+            return false;
+        }
+        // Only the first entry (DC in zigzag order too) is needed
+        decoder->quant_dc[id] = precision ? read_u16(p + 1) : p[1];
+        p += size;
+    }
+    return true;
+}
+
+// Decode one block, only the DC difference is kept
+static bool decode_block(jpeg_dc_reader_t *r, const jpeg_dc_huffman_t *dc, const jpeg_dc_huffman_t *ac, int *diff){
+    int s = reader_decode(r, dc);
+    if (s < 0 || s > 11){
+        return false;
+    }
+    *diff = reader_extend(r, s);
+    for (int k = 1; k < 64; ){
+        // Most coefficients are short, skip their code and bits in one go
+        reader_fill(r);
+        int fast = ac->lookup_ac[r->bits >> 24];
+        if (fast){
+            r->bits <<= fast & 0x0F;
+            r->count -= fast & 0x0F;
+            k += fast >> 8;
+            continue;
+        }
+        int rs = reader_decode(r, ac);
+        if (rs < 0){
+            return false;
+        }
+        if (rs & 0x0F){
+            k += (rs >> 4) + 1;
+            reader_skip(r, rs & 0x0F);
+        } else if (rs == 0xF0){
+            k += 16; // 16 zeros
+        } else {
+            break;   // End of block
+        }
+    }
+    return true;
+}
+
+static uint8_t dc_pixel(int dc, int quant){
+    int v = ((dc * quant + 4) >> 3) + 128; // 1x1 IDCT: DC / 8, level shifted
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+bool jpeg_dc_thumbnail(jpeg_dc_decoder_t *decoder, const uint8_t *jpg, size_t len,
+                       uint8_t *out, size_t out_size, int *width, int *height){
+    jpeg_dc_component_t components[JPEG_DC_COMPONENTS];
+    int component_count = 0;
+    int image_w = 0;
+    int image_h = 0;
+    int restart_interval = 0;
+    const uint8_t *end = jpg + len;
+    const uint8_t *p = jpg + 2;
+    const uint8_t *scan = NULL;
+    size_t scan_len = 0;
+
+    if (len < 4 || jpg[0] != 0xFF || jpg[1] != 0xD8){
+        return false;
+    }
+
+    // Markers up to the start of scan
+    while (true){
+        while (p < end && *p != 0xFF){
+            p++;
+        }
+        while (p < end && *p == 0xFF){
+            p++; // Fill bytes
+        }
+        if (end - p < 3){
+            return false;
+        }
+        int marker = *p++;
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)){
+            continue; // No length
+        }
+        size_t segment_len = read_u16(p);
+        if (segment_len < 2 || (size_t)(end - p) < segment_len){
+            return false;
+        }
+        const uint8_t *segment = p + 2;
+        segment_len -= 2;
+        p += segment_len + 2;
+
+        if (marker == 0xC0 || marker == 0xC1){
+            // Baseline or extended sequential Huffman frame
+            if (segment_len < 6 || segment[0] != 8){
+                return false;
+            }
+            image_h = read_u16(segment + 1);
+            image_w = read_u16(segment + 3);
+            component_count = segment[5];
+            if (!image_w || !image_h || !component_count || component_count > JPEG_DC_COMPONENTS ||
+                segment_len < 6 + 3 * (size_t)component_count){
+                return false;
+            }
+            for (int i = 0; i < component_count; i++){
+                const uint8_t *c = segment + 6 + 3 * i;
+                components[i].id = c[0];
+                components[i].h = c[1] >> 4;
+                components[i].v = c[1] & 0x0F;
+                components[i].quant = c[2] & 3;
+                if (!components[i].h || !components[i].v){
+                    return false;
+                }
+            }
+        }
+        else if (marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC){
+            return false; // Progressive, lossless or arithmetic coding
+        }
+        else if (marker == 0xC4){
+            if (!parse_dht(decoder, segment, segment_len)){
+                return false;
+            }
+        }
+        else if (marker == 0xDB){
+            if (!parse_dqt(decoder, segment, segment_len)){
+                return false;
+            }
+        }
+        else if (marker == 0xDD){
+            if (segment_len < 2){
+                return false;
+            }
+            restart_interval = read_u16(segment);
+        }
+        else if (marker == 0xDA){
+            scan = segment;
+            scan_len = segment_len;
+            break;
+        }
+        else if (marker == 0xD9){
+            return false; // No scan
+        }
+    }
+
+    // Start of scan, the luma component has to be in it
+    if (!component_count || scan_len < 1){
+        return false;
+    }
+    int scan_count = scan[0];
+    if (!scan_count || scan_count > component_count || scan_len < 1 + 2 * (size_t)scan_count + 3){
+        return false;
+    }
+    jpeg_dc_component_t *scan_components[JPEG_DC_COMPONENTS];
+    for (int i = 0; i < scan_count; i++){
+        const uint8_t *c = scan + 1 + 2 * i;
+        scan_components[i] = NULL;
+        for (int j = 0; j < component_count; j++){
+            if (components[j].id == c[0]){
+                scan_components[i] = &components[j];
+            }
+        }
+        if (!scan_components[i]){
+            return false;
+        }
+        scan_components[i]->dc_table = c[1] >> 4;
+        scan_components[i]->ac_table = c[1] & 0x0F;
+        scan_components[i]->pred = 0;
+        if (scan_components[i]->dc_table >= JPEG_DC_TABLES || scan_components[i]->ac_table >= JPEG_DC_TABLES ||
+            !decoder->dc[scan_components[i]->dc_table].defined || !decoder->ac[scan_components[i]->ac_table].defined){
+            return false;
+        }
+    }
+    jpeg_dc_component_t *luma = &components[0];
+    if (scan_components[0] != luma){
+        return false;
+    }
+
+    int h_max = 1;
+    int v_max = 1;
+    for (int i = 0; i < component_count; i++){
+        h_max = components[i].h > h_max ? components[i].h : h_max;
+        v_max = components[i].v > v_max ? components[i].v : v_max;
+    }
+    // Luma blocks actually covering the image
+    int blocks_w = (image_w * luma->h + 8 * h_max - 1) / (8 * h_max);
+    int blocks_h = (image_h * luma->v + 8 * v_max - 1) / (8 * v_max);
+    if ((size_t)blocks_w * blocks_h > out_size){
+        return false;
+    }
+
+    // A scan with a single component is not interleaved: one block per MCU, in raster order.
+    // Otherwise an MCU holds h x v blocks of each component.
+    bool interleaved = scan_count > 1;
+    int mcus_w = interleaved ? (image_w + 8 * h_max - 1) / (8 * h_max) : blocks_w;
+    int mcus_h = interleaved ? (image_h + 8 * v_max - 1) / (8 * v_max) : blocks_h;
+    int quant = decoder->quant_dc[luma->quant];
+
+    jpeg_dc_reader_t reader = {scan + scan_len, end, 0, 0, false};
+    int mcus = mcus_w * mcus_h;
+    for (int mcu = 0; mcu < mcus; mcu++){
+        if (restart_interval && mcu && mcu % restart_interval == 0){
+            if (!reader_restart(&reader)){
+                return false;
+            }
+            for (int i = 0; i < scan_count; i++){
+                scan_components[i]->pred = 0;
+            }
+        }
+        int mcu_x = mcu % mcus_w;
+        int mcu_y = mcu / mcus_w;
+        for (int i = 0; i < scan_count; i++){
+            jpeg_dc_component_t *c = scan_components[i];
+            int h = interleaved ? c->h : 1;
+            int v = interleaved ? c->v : 1;
+            for (int by = 0; by < v; by++){
+                for (int bx = 0; bx < h; bx++){
+                    int diff;
+                    if (!decode_block(&reader, &decoder->dc[c->dc_table], &decoder->ac[c->ac_table], &diff)){
+                        return false;
+                    }
+                    c->pred += diff;
+                    if (c != luma){
+                        continue;
+                    }
+                    // Blocks padding the last MCU row/column are dropped
+                    int x = mcu_x * h + bx;
+                    int y = mcu_y * v + by;
+                    if (x < blocks_w && y < blocks_h){
+                        out[y * blocks_w + x] = dc_pixel(c->pred, quant);
+                    }
+                }
+            }
+        }
+    }
+
+    *width = blocks_w;
+    *height = blocks_h;
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef JPEG_DC_H
+#define JPEG_DC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// DC-only baseline JPEG decoder: the mean of every 8x8 luma block, a 1/8 scale
+// grayscale thumbnail (40x30 from QVGA) without any IDCT.
+// AC coefficients still have to be Huffman decoded to find the next block,
+// they are skipped without being dequantized. Handles any chroma subsampling,
+// grayscale frames and restart intervals. Progressive and arithmetic coded
+// JPEGs are refused.
+
+#define JPEG_DC_TABLES 2 // Huffman tables of each class allowed in baseline JPEG
+
+typedef struct {
+    uint8_t lookup_len[256];  // Code length for codes up to 8 bits, by 8 bit prefix, 0 if longer
+    uint8_t lookup_symbol[256];
+    int32_t maxcode[17];      // Largest code of each length, -1 if none
+    int32_t offset[17];       // Symbol index of a code of each length
+    uint8_t symbols[256];
+    uint16_t lookup_ac[256];  // AC tables: code and coefficient bits together when they fit in 8 bits,
+                              // zigzag advance << 8 | bits, 0 otherwise
+    bool defined;
+} jpeg_dc_huffman_t;
+
+// Tables from the last frame, reused by frames without DHT/DQT
+typedef struct {
+    jpeg_dc_huffman_t dc[JPEG_DC_TABLES];
+    jpeg_dc_huffman_t ac[JPEG_DC_TABLES];
+    uint16_t quant_dc[4];     // DC entry of each quantization table
+} jpeg_dc_decoder_t;
+
+// Decode the thumbnail into out, one byte per block, width x height blocks.
+// False if the frame is not a baseline JPEG, is corrupt or the thumbnail is larger than out_size.
+bool jpeg_dc_thumbnail(jpeg_dc_decoder_t *decoder, const uint8_t *jpg, size_t len,
+                       uint8_t *out, size_t out_size, int *width, int *height);
+
+#endif // JPEG_DC_H
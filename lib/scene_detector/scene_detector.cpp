@@ -0,0 +1,58 @@
+#include "scene_detector.h"
+#include <string.h>
+
+void scene_reset(scene_state_t *state, int64_t now_ms){
+    state->last_len = 0;
+    state->signature_len = 0;
+    state->last_change_ms = now_ms;
+    state->last_sent_ms = 0;
+    state->idle = false;
+}
+
+void scene_rearm(scene_state_t *state, int64_t now_ms){
+    state->last_change_ms = now_ms;
+    state->idle = false;
+}
+
+static bool scene_changed(const scene_config_t *config, scene_state_t *state, size_t len,
+                          const uint8_t *signature, size_t signature_len){
+    bool changed = false;
+
+    if (!state->last_len){
+        changed = true;
+    } else {
+        size_t delta = len > state->last_len ? len - state->last_len : state->last_len - len;
+        changed = delta > state->last_len * config->size_threshold;
+    }
+    state->last_len = len;
+
+    if (signature && signature_len && signature_len <= SCENE_SIGNATURE_MAX){
+        if (signature_len != state->signature_len){
+            changed = true;
+        } else if (!changed){
+            uint32_t sum = 0;
+            for (size_t i = 0; i < signature_len; i++){
+                int diff = (int)signature[i] - state->signature[i];
+                sum += diff < 0 ? -diff : diff;
+            }
+            changed = sum > (uint32_t)config->signature_threshold * signature_len;
+        }
+        memcpy(state->signature, signature, signature_len);
+        state->signature_len = signature_len;
+    }
+    return changed;
+}
+
+bool scene_update(const scene_config_t *config, scene_state_t *state, size_t len,
+                  const uint8_t *signature, size_t signature_len, int64_t now_ms){
+    if (scene_changed(config, state, len, signature, signature_len)){
+        state->last_change_ms = now_ms;
+    }
+    state->idle = now_ms - state->last_change_ms >= config->idle_after_ms;
+
+    if (!state->idle || now_ms - state->last_sent_ms >= config->keepalive_ms){
+        state->last_sent_ms = now_ms;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,40 @@
+#ifndef SCENE_DETECTOR_H
+#define SCENE_DETECTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Cheap change detector used to stop streaming near-identical frames while
+// the car is parked. A frame counts as a change when its JPEG size moves
+// by more than size_threshold compared to the previous frame, or when its
+// signature (small luma thumbnail, optional) differs by more than
+// signature_threshold on average.
+
+#define SCENE_SIGNATURE_MAX 1200 // 40x30, a 1/8 QVGA thumbnail
+
+typedef struct {
+    float size_threshold;       // Relative JPEG size change, 0.02 = 2%
+    int signature_threshold;    // Mean absolute difference per signature sample
+    uint32_t idle_after_ms;     // Without change for this long the scene is idle
+    uint32_t keepalive_ms;      // While idle, still send one frame this often
+} scene_config_t;
+
+typedef struct {
+    size_t last_len;
+    uint8_t signature[SCENE_SIGNATURE_MAX];
+    size_t signature_len;
+    int64_t last_change_ms;
+    int64_t last_sent_ms;
+    bool idle;
+} scene_state_t;
+
+void scene_reset(scene_state_t *state, int64_t now_ms);
+
+// Motion was commanded: treat the scene as changing right now
+void scene_rearm(scene_state_t *state, int64_t now_ms);
+
+// Feed a frame, true if it should be sent. signature may be NULL.
+bool scene_update(const scene_config_t *config, scene_state_t *state, size_t len,
+                  const uint8_t *signature, size_t signature_len, int64_t now_ms);
+
+#endif // SCENE_DETECTOR_H
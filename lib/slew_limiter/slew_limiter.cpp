@@ -0,0 +1,44 @@
+#include "slew_limiter.h"
+
+#define SLEW_ONE 256 // 1/256 duty per unit
+
+static int32_t slew_limit_step(int limit, int tick_hz){
+    if (limit <= 0 || tick_hz <= 0) return INT32_MAX;
+    int32_t step = (int32_t)limit * SLEW_ONE / tick_hz;
+    return step > 0 ? step : 1;
+}
+
+void slew_init(slew_state_t *state, const slew_limits_t *limits, int tick_hz){
+    state->accel_step = slew_limit_step(limits->accel, tick_hz);
+    state->brake_step = slew_limit_step(limits->brake, tick_hz);
+    state->reverse_step = slew_limit_step(limits->reverse, tick_hz);
+    state->value = 0;
+}
+
+void slew_reset(slew_state_t *state, int duty){
+    state->value = (int32_t)duty * SLEW_ONE;
+}
+
+// Move value toward target by at most step, never past it
+static int32_t slew_toward(int32_t value, int32_t target, int32_t step){
+    if (value < target) return target - value > step ? value + step : target;
+    return value - target > step ? value - step : target;
+}
+
+int slew_step(slew_state_t *state, int target){
+    int32_t goal = (int32_t)target * SLEW_ONE;
+    int32_t value = state->value;
+
+    if ((value > 0 && goal < 0) || (value < 0 && goal > 0)){
+        // Direction change, brake down to 0 first
+        value = slew_toward(value, 0, state->reverse_step);
+    } else if ((value >= 0 && goal > value) || (value <= 0 && goal < value)){
+        value = slew_toward(value, goal, state->accel_step);
+    } else {
+        value = slew_toward(value, goal, state->brake_step);
+    }
+    state->value = value;
+
+    // Round to the nearest duty, halves away from 0
+    return value >= 0 ? (value + SLEW_ONE / 2) / SLEW_ONE : -((-value + SLEW_ONE / 2) / SLEW_ONE);
+}
@@ -0,0 +1,38 @@
+#ifndef SLEW_LIMITER_H
+#define SLEW_LIMITER_H
+
+#include <stdint.h>
+
+// Rate limiter for one motor's duty cycle (-100..100), stepped on a fixed tick.
+// Integer arithmetic, the duty is tracked in 1/256 so slow limits still move
+// at high tick rates.
+//
+// Three limits, in duty percent per second (0 = no limit):
+//   accel   - speeding up, away from 0
+//   brake   - slowing down toward 0 while the target keeps the direction (or is 0)
+//   reverse - slowing down toward 0 when the target is in the other direction,
+//             the H-bridge flips at 0 and speeds up with accel afterwards
+
+typedef struct {
+    int accel;
+    int brake;
+    int reverse;
+} slew_limits_t;
+
+typedef struct {
+    int32_t accel_step;   // Largest change per tick, 1/256 duty
+    int32_t brake_step;
+    int32_t reverse_step;
+    int32_t value;        // Current duty, 1/256
+} slew_state_t;
+
+// Convert the limits to steps for a tick rate, the duty starts at 0
+void slew_init(slew_state_t *state, const slew_limits_t *limits, int tick_hz);
+
+// Jump to a duty without limiting (e.g. emergency stop)
+void slew_reset(slew_state_t *state, int duty);
+
+// Move one tick toward target, returns the duty to apply
+int slew_step(slew_state_t *state, int target);
+
+#endif // SLEW_LIMITER_H
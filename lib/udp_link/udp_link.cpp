@@ -0,0 +1,33 @@
+#include "udp_link.h"
+#include <string.h>
+
+void udp_link_init(udp_link_t *link, uint32_t max_age_ms){
+    memset(link, 0, sizeof(*link));
+    link->max_age_ms = max_age_ms;
+}
+
+udp_link_verdict_t udp_link_check(udp_link_t *link, const void *packet, int len,
+                                  uint32_t addr, uint16_t port, uint32_t now_ms){
+    const udp_cmd_t *cmd = (const udp_cmd_t *)packet;
+    if (len != (int)sizeof(udp_cmd_t) || cmd->magic != UDP_CMD_MAGIC){
+        link->dropped++;
+        return UDP_LINK_MALFORMED;
+    }
+    bool same_peer = link->have_peer && addr == link->peer_addr && port == link->peer_port;
+    if (same_peer && !udp_seq_newer(cmd->seq, link->last_seq)){
+        link->dropped++;
+        return UDP_LINK_OLD;
+    }
+    if ((cmd->flags & UDP_FLAG_SYNCED) && (int32_t)(now_ms - cmd->client_ms) > (int32_t)link->max_age_ms){
+        link->dropped++;
+        return UDP_LINK_STALE;
+    }
+    link->last_seq = cmd->seq;
+    if (!same_peer){
+        link->have_peer = true;
+        link->peer_addr = addr;
+        link->peer_port = port;
+        return UDP_LINK_NEW_PEER;
+    }
+    return UDP_LINK_ACCEPT;
+}
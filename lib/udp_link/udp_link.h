@@ -0,0 +1,37 @@
+#ifndef UDP_LINK_H
+#define UDP_LINK_H
+
+#include <stdint.h>
+#include "control_protocol.h"
+
+// Acceptance of the UDP control packets (udp_cmd_t), without the socket so
+// the rules can be run on the host. Commands from the newest sender drive:
+// a packet from another address takes over and starts its own sequence.
+// Within one sender, only packets newer than the last accepted one count.
+// Synced packets (UDP_FLAG_SYNCED) older than max_age_ms are dropped, a newer
+// one is on its way.
+
+typedef enum {
+    UDP_LINK_ACCEPT,    // Drive with it
+    UDP_LINK_NEW_PEER,  // Drive with it, it came from a new sender
+    UDP_LINK_MALFORMED, // Wrong size or magic
+    UDP_LINK_OLD,       // Duplicate or overtaken by a newer packet
+    UDP_LINK_STALE,     // Held up in the network
+} udp_link_verdict_t;
+
+typedef struct {
+    uint32_t max_age_ms;
+    bool have_peer;
+    uint32_t peer_addr;  // Sender driving, network order as in sockaddr_in
+    uint16_t peer_port;
+    uint32_t last_seq;
+    uint32_t dropped;    // Packets refused so far, reported in the telemetry
+} udp_link_t;
+
+void udp_link_init(udp_link_t *link, uint32_t max_age_ms);
+
+// Check a datagram of len bytes from addr:port, now_ms in the device clock
+udp_link_verdict_t udp_link_check(udp_link_t *link, const void *packet, int len,
+                                  uint32_t addr, uint16_t port, uint32_t now_ms);
+
+#endif // UDP_LINK_H
@@ -0,0 +1,56 @@
+# Gzip the web pages into C headers served straight from flash, like camera_index.h.
+# Runs before every PlatformIO build (extra_scripts in platformio.ini),
+# or by hand: python scripts/embed_web.py
+import gzip
+import io
+import os
+
+try:
+    Import("env")
+    project_dir = env["PROJECT_DIR"]
+except NameError:
+    project_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Source page, generated header, array name
+PAGES = [
+    ("web/index.html", "src/index_html.h", "index_html_gz"),
+]
+
+
+def gzip_bytes(name, data):
+    # No timestamp, the output only changes with the page
+    out = io.BytesIO()
+    with gzip.GzipFile(filename=name, mode="wb", compresslevel=9, fileobj=out, mtime=0) as f:
+        f.write(data)
+    return out.getvalue()
+
+
+def header(source, name, data):
+    lines = [
+        "// Generated by scripts/embed_web.py from %s, do not edit" % source,
+        "//File: %s.gz, Size: %d" % (os.path.basename(source), len(data)),
+        "#define %s_len %d" % (name, len(data)),
+        "const uint8_t %s[] = {" % name,
+    ]
+    for i in range(0, len(data), 16):
+        row = ", ".join("0x%02X" % b for b in data[i:i + 16])
+        lines.append(" " + row + ("," if i + 16 < len(data) else ""))
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+for source, target, name in PAGES:
+    with open(os.path.join(project_dir, source), "rb") as f:
+        html = f.read()
+    data = gzip_bytes(os.path.basename(source), html)
+    text = header(source, name, data)
+
+    # Only touch the header when the page changed, to avoid rebuilds
+    path = os.path.join(project_dir, target)
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                continue
+    with open(path, "w") as f:
+        f.write(text)
+    print("Embedded %s: %d B, %d B gzipped" % (source, len(html), len(data)))
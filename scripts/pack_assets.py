@@ -0,0 +1,118 @@
+# Pack the files of data/ into a read-only bundle for the "assets" flash partition,
+# served memory-mapped by src/asset_bundle.cpp.
+#
+# PlatformIO: pio run -t uploadassets
+# By hand:    python scripts/pack_assets.py [data_dir] [output.bin]
+#
+# Layout, little endian:
+#   header  "RCAB", u16 version, u16 count, u32 total size
+#   index   count entries sorted by path: char path[48], u32 offset, u32 size, u32 flags, u32 etag
+#   data    each file at its offset, 4 byte aligned
+import gzip
+import io
+import os
+import struct
+import sys
+
+MAGIC = b"RCAB"
+VERSION = 1
+PATH_SIZE = 48
+FLAG_GZIP = 1
+GZIP_TYPES = (".html", ".htm", ".js", ".css", ".svg", ".json", ".txt")
+
+HEADER = struct.Struct("<4sHHI")
+ENTRY = struct.Struct("<%dsIIII" % PATH_SIZE)
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def gzip_bytes(data):
+    out = io.BytesIO()
+    with gzip.GzipFile(mode="wb", compresslevel=9, fileobj=out, mtime=0) as f:
+        f.write(data)
+    return out.getvalue()
+
+
+def pack(data_dir):
+    files = []
+    for root, _, names in os.walk(data_dir):
+        for name in names:
+            full = os.path.join(root, name)
+            path = "/" + os.path.relpath(full, data_dir).replace(os.sep, "/")
+            if len(path) >= PATH_SIZE:
+                raise ValueError("Path too long for the bundle: " + path)
+            with open(full, "rb") as f:
+                files.append((path, f.read()))
+    files.sort()
+
+    offset = HEADER.size + ENTRY.size * len(files)
+    index = b""
+    blobs = b""
+    for path, data in files:
+        flags = 0
+        if path.endswith(GZIP_TYPES):
+            packed = gzip_bytes(data)
+            if len(packed) < len(data):
+                data = packed
+                flags |= FLAG_GZIP
+        offset += (-offset) % 4
+        blobs += b"\0" * ((offset - HEADER.size - ENTRY.size * len(files)) - len(blobs))
+        index += ENTRY.pack(path.encode(), offset, len(data), flags, fnv1a(data))
+        blobs += data
+        offset += len(data)
+    return HEADER.pack(MAGIC, VERSION, len(files), offset) + index + blobs
+
+
+def partition_offset(project_dir, label):
+    with open(os.path.join(project_dir, "partitions.csv")) as f:
+        for line in f:
+            fields = [x.strip() for x in line.split("#")[0].split(",")]
+            if len(fields) >= 5 and fields[0] == label:
+                return int(fields[3], 0), int(fields[4], 0)
+    raise ValueError("No %s partition in partitions.csv" % label)
+
+
+try:
+    Import("env")
+except NameError:
+    env = None
+
+if env is not None:
+    project_dir = env["PROJECT_DIR"]
+    bundle_path = os.path.join(env.subst("$BUILD_DIR"), "assets.bin")
+
+    def build_bundle(*args, **kwargs):
+        bundle = pack(os.path.join(project_dir, "data"))
+        offset, size = partition_offset(project_dir, "assets")
+        if len(bundle) > size:
+            raise ValueError("Asset bundle is %d B, the partition only %d B" % (len(bundle), size))
+        with open(bundle_path, "wb") as f:
+            f.write(bundle)
+        print("Asset bundle: %d B at 0x%x" % (len(bundle), offset))
+
+    offset, _ = partition_offset(project_dir, "assets")
+    env.AddCustomTarget(
+        name="uploadassets",
+        dependencies=None,
+        actions=[
+            build_bundle,
+            # Custom targets don't look for the port themselves, upload_port still wins when set
+            env.VerboseAction(env.AutodetectUploadPort, "Looking for upload port..."),
+            '"$PYTHONEXE" "$UPLOADER" --chip $BOARD_MCU --port "$UPLOAD_PORT" --baud $UPLOAD_SPEED '
+            'write_flash 0x%x "%s"' % (offset, bundle_path),
+        ],
+        title="Upload assets",
+        description="Pack data/ and flash it to the assets partition",
+    )
+elif __name__ == "__main__":
+    data_dir = sys.argv[1] if len(sys.argv) > 1 else "data"
+    output = sys.argv[2] if len(sys.argv) > 2 else "assets.bin"
+    bundle = pack(data_dir)
+    with open(output, "wb") as f:
+        f.write(bundle)
+    print("%s: %d B" % (output, len(bundle)))
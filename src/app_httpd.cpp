@@ -10,18 +10,34 @@
 #include "esp_camera.h"
 #include "img_converters.h"
 #include "camera_index.h"
+#include "index_html.h"
 #include "Arduino.h"
 
 // Pins and Neopixel includes
 #include "Adafruit_NeoPixel.h"
 #include <user_define.h>
 
+// Stream includes
+#include "frame_broadcaster.h"
+#include "clip_recorder.h"
+#include "burst_recorder.h"
+#include "stream_preview.h"
+#include "lwip/sockets.h"
+#include <bitrate_controller.h>
+#include <camera_roi.h>
+
 // Motor control includes
 #include "driver/mcpwm.h"
+#include "motor_control.h"
+#include "control_protocol.h"
 
 // Include for Cegep Logo
 #include "FS.h"
 #include "LittleFS.h"
+#include "asset_bundle.h"
+
+// UDP command port
+#include "udp_control.h"
 
 // Neopixel
 Adafruit_NeoPixel pixels(NEOPIXEL_NUMBER, NEOPIXEL_PIN, NEO_GRB + NEO_KHZ800);
@@ -32,6 +48,8 @@ int batteryPercentage = 100; // Placeholder for battery percentage
 
 volatile float camera_fps = 0.0; // Placeholder for camera FPS
 
+static bool stream_raw = STREAM_RAW_WRITE; // Framing used by new stream clients
+
 // Placeholder for functions
 void updateBatteryPercentage();
 void updateNeoPixelColor();
@@ -39,6 +57,7 @@ void initLITTLEFS();
 void startCameraServer(void);
 void rcCar_setup();
 void rcCar_stop();
+void rcCar_set_duty(int right, int left);
 
 typedef struct {
   httpd_req_t *req;
@@ -48,7 +67,7 @@ typedef struct {
 #define PART_BOUNDARY "123456789000000000000987654321"
 static const char *_STREAM_CONTENT_TYPE = "multipart/x-mixed-replace;boundary=" PART_BOUNDARY;
 static const char *_STREAM_BOUNDARY = "\r\n--" PART_BOUNDARY "\r\n";
-static const char *_STREAM_PART = "Content-Type: image/jpeg\r\nContent-Length: %u\r\n\r\n";
+static const char *_STREAM_PART = "Content-Type: image/jpeg\r\nContent-Length: %u\r\nX-Timestamp: %lld\r\nX-Frame-Seq: %u\r\n\r\n";
 
 httpd_handle_t stream_httpd = NULL;
 httpd_handle_t camera_httpd = NULL;
@@ -65,21 +84,186 @@ static size_t jpg_encode_stream(void *arg, size_t index, const void *data, size_
     return len;
 }
 
+static int camera_set_framesize(sensor_t *s, framesize_t framesize);
+
+// Photo mode: named framesizes accepted by /capture?size=
+static const struct {
+    const char *name;
+    framesize_t framesize;
+} photo_sizes[] = {
+    {"uxga", FRAMESIZE_UXGA},
+    {"sxga", FRAMESIZE_SXGA},
+    {"xga", FRAMESIZE_XGA},
+    {"svga", FRAMESIZE_SVGA},
+    {"vga", FRAMESIZE_VGA},
+};
+
+static int photo_framesize(const char *size){
+    for (size_t i = 0; i < sizeof(photo_sizes) / sizeof(photo_sizes[0]); i++){
+        if (!strcmp(size, photo_sizes[i].name)){
+            return photo_sizes[i].framesize;
+        }
+    }
+    if (isdigit((unsigned char)size[0])){
+        return atoi(size);
+    }
+    return -1;
+}
+
+// Take the sensor from the stream, switch to the photo framesize, wait for it to
+// settle and grab one still, then give the stream its framesize back.
+// The camera buffers are sized for the largest framesize at init, nothing is allocated.
+static esp_err_t photo_capture(httpd_req_t *req, framesize_t framesize){
+    sensor_t *s = esp_camera_sensor_get();
+    if (s->pixformat != PIXFORMAT_JPEG || framesize > broadcaster_max_framesize()){
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Photo size not available");
+        return ESP_FAIL;
+    }
+
+    int64_t start = esp_timer_get_time();
+    if (!broadcaster_pause(pdMS_TO_TICKS(1000))){
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    framesize_t previous = s->status.framesize;
+    bool switched = framesize != previous;
+    if (switched){
+        s->set_framesize(s, framesize); // Full field of view
+    }
+    int64_t switch_end = esp_timer_get_time();
+
+    // Frames already in the pipeline still have the old size, then give the
+    // exposure a few frames to adapt to the new mode
+    camera_fb_t *fb = NULL;
+    int settle = switched ? PHOTO_SETTLE_FRAMES : 0;
+    int64_t deadline = switch_end + PHOTO_TIMEOUT_MS * 1000LL;
+    while (esp_timer_get_time() < deadline){
+        fb = esp_camera_fb_get();
+        if (fb && fb->width == resolution[framesize].width && settle-- <= 0){
+            break;
+        }
+        if (fb){
+            esp_camera_fb_return(fb);
+            fb = NULL;
+        }
+    }
+    int64_t grab_end = esp_timer_get_time();
+
+    // Keep the still and hand the sensor back right away
+    if (switched){
+        camera_set_framesize(s, previous);
+    }
+    broadcaster_resume();
+    int64_t restore_end = esp_timer_get_time();
+
+    if (!fb){
+        Serial.println("Photo capture failed");
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    char timestamp_hdr[24];
+    char photo_ms_hdr[12];
+    snprintf(timestamp_hdr, sizeof(timestamp_hdr), "%lld", (int64_t)fb->timestamp.tv_sec * 1000000 + fb->timestamp.tv_usec);
+    snprintf(photo_ms_hdr, sizeof(photo_ms_hdr), "%u", (uint32_t)((restore_end - start) / 1000));
+    httpd_resp_set_hdr(req, "X-Timestamp", timestamp_hdr);
+    httpd_resp_set_hdr(req, "X-Photo-Ms", photo_ms_hdr);
+    esp_err_t res = httpd_resp_send(req, (const char *)fb->buf, fb->len);
+    Serial.printf("Photo: %ux%u %uB, pause+switch %ums, settle+grab %ums, restore %ums\n",
+                  fb->width, fb->height, (uint32_t)fb->len,
+                  (uint32_t)((switch_end - start) / 1000),
+                  (uint32_t)((grab_end - switch_end) / 1000),
+                  (uint32_t)((restore_end - grab_end) / 1000));
+    esp_camera_fb_return(fb);
+    return res;
+}
+
+// Long downloads, bursts and photos are served by the stream server on port 81:
+// port 80 has a single httpd task that must stay free for the joystick. Port 80 links are redirected.
+static esp_err_t media_redirect_handler(httpd_req_t *req){
+    char host[64];
+    char location[sizeof(host) + 16 + sizeof(req->uri)];
+    if (httpd_req_get_hdr_value_str(req, "Host", host, sizeof(host)) != ESP_OK){
+        strcpy(host, "192.168.4.1"); // Soft AP address
+    }
+    char *port = strchr(host, ':');
+    if (port){
+        *port = 0;
+    }
+    snprintf(location, sizeof(location), "http://%s:81%s", host, req->uri);
+    httpd_resp_set_status(req, "307 Temporary Redirect");
+    httpd_resp_set_hdr(req, "Location", location);
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    return httpd_resp_send(req, NULL, 0);
+}
+
 static esp_err_t capture_handler(httpd_req_t *req){
     camera_fb_t *fb = NULL;
     esp_err_t res = ESP_OK;
     int64_t fr_start = esp_timer_get_time();
+    char query[64];
+    char param[16];
+    char timestamp_hdr[24];
+    char seq_hdr[12];
+    int max_age_ms = CAPTURE_MAX_AGE_MS;
+    int photo_size = -1;
+
+    size_t query_len = httpd_req_get_url_query_len(req) + 1;
+    if (query_len > 1 && query_len <= sizeof(query) &&
+        httpd_req_get_url_query_str(req, query, query_len) == ESP_OK){
+        if (httpd_query_key_value(query, "max_age_ms", param, sizeof(param)) == ESP_OK){
+            max_age_ms = atoi(param);
+        }
+        if (httpd_query_key_value(query, "size", param, sizeof(param)) == ESP_OK){
+            photo_size = photo_framesize(param);
+            if (photo_size < 0){
+                httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Unknown size");
+                return ESP_FAIL;
+            }
+        }
+    }
+
+    httpd_resp_set_type(req, "image/jpeg");
+    httpd_resp_set_hdr(req, "Content-Disposition", "inline; filename=capture.jpg");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
 
+    if (photo_size >= 0){
+        if (req->handle == camera_httpd){
+            return media_redirect_handler(req); // Up to PHOTO_TIMEOUT_MS plus the send, keep it off port 80
+        }
+        return photo_capture(req, (framesize_t)photo_size);
+    }
+
+    // The capture task owns the sensor, take its latest frame or wait for the next
+    // one. Bounded well under MOTOR_TIMEOUT_MS, port 80 also carries the controls.
+    shared_frame_t *frame = broadcaster_grab(max_age_ms * 1000LL, pdMS_TO_TICKS(CAPTURE_WAIT_MS));
+    if (frame){
+        snprintf(timestamp_hdr, sizeof(timestamp_hdr), "%lld", frame->timestamp);
+        snprintf(seq_hdr, sizeof(seq_hdr), "%u", frame->seq);
+        httpd_resp_set_hdr(req, "X-Timestamp", timestamp_hdr);
+        httpd_resp_set_hdr(req, "X-Frame-Seq", seq_hdr);
+        res = httpd_resp_send(req, (const char *)frame->buf, frame->len);
+        Serial.printf("JPG: %uB from stream, %ums old\n", (uint32_t)frame->len,
+                      (uint32_t)((esp_timer_get_time() - frame->timestamp) / 1000));
+        broadcaster_release(frame);
+        return res;
+    }
+    if (broadcaster_running()){
+        // Paused for a photo, or no fresh frame in time. Reading the sensor here
+        // would take a frame buffer away from the capture task.
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "text/plain");
+        return httpd_resp_send(req, "No frame", 8);
+    }
+
+    // No frame pool, grab a frame from the sensor
     fb = esp_camera_fb_get();
     if (!fb){
         Serial.println("Camera capture failed");
         httpd_resp_send_500(req);
         return ESP_FAIL;
     }
-
-    httpd_resp_set_type(req, "image/jpeg");
-    httpd_resp_set_hdr(req, "Content-Disposition", "inline; filename=capture.jpg");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    snprintf(timestamp_hdr, sizeof(timestamp_hdr), "%lld", (int64_t)fb->timestamp.tv_sec * 1000000 + fb->timestamp.tv_usec);
+    httpd_resp_set_hdr(req, "X-Timestamp", timestamp_hdr);
 
     size_t out_len, out_width, out_height;
     uint8_t *out_buf;
@@ -92,7 +276,7 @@ static esp_err_t capture_handler(httpd_req_t *req){
     else
     {
         jpg_chunking_t jchunk = {req, 0};
-        res = frame2jpg_cb(fb, 80, jpg_encode_stream, &jchunk) ? ESP_OK : ESP_FAIL;
+        res = frame2jpg_cb(fb, broadcaster_raw_quality(), jpg_encode_stream, &jchunk) ? ESP_OK : ESP_FAIL;
         httpd_resp_send_chunk(req, NULL, 0);
         fb_len = jchunk.len;
     }
@@ -102,84 +286,543 @@ static esp_err_t capture_handler(httpd_req_t *req){
     return res;
 }
 
-static esp_err_t stream_handler(httpd_req_t *req){
-    camera_fb_t *fb = NULL;
-    esp_err_t res = ESP_OK;
-    size_t _jpg_buf_len = 0;
-    uint8_t *_jpg_buf = NULL;
-    char *part_buf[64];
-    static int64_t last_frame = 0;
-    static int64_t last_fps_time = 0;
-    static int frame_count = 0;
+// Digital zoom: the sensor crops its array so the JPEG only covers the region of interest
+static camera_roi_t camera_roi = {100, 500, 500};
 
-    if (!last_frame){
-        last_frame = esp_timer_get_time();
-        last_fps_time = last_frame;
+static int roi_apply(sensor_t *s){
+    if (camera_roi.zoom <= 100){
+        return s->set_framesize(s, s->status.framesize); // Full field of view
+    }
+    int out_w = resolution[s->status.framesize].width;
+    int out_h = resolution[s->status.framesize].height;
+
+    if (s->id.PID == OV2640_PID){
+        // set_res_raw() is the driver's set_window(mode, offset, window, output).
+        // The binned SVGA mode runs twice as fast, keep it while it has enough pixels.
+        int mode = (800 * 100 / camera_roi.zoom >= out_w) ? 1 : 0; // 1: SVGA 800x600, 0: UXGA 1600x1200
+        int sensor_w = mode ? 800 : 1600;
+        int sensor_h = mode ? 600 : 1200;
+        roi_window_t win = roi_window(&camera_roi, sensor_w, sensor_h, out_w, out_h, 8);
+        return s->set_res_raw(s, mode, 0, 0, 0, win.x, win.y, win.width, win.height, out_w, out_h, false, false);
+    }
+    if (s->id.PID == OV3660_PID){
+        // Timings of the driver's 4:3 full frame window, only the array window moves
+        roi_window_t win = roi_window(&camera_roi, 2048, 1536, out_w, out_h, 8);
+        return s->set_res_raw(s, win.x, win.y, win.x + win.width + 31, win.y + win.height + 11,
+                              16, 6, 2300, 1564, out_w, out_h, true, false);
     }
+    return -1;
+}
 
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    res = httpd_resp_set_type(req, _STREAM_CONTENT_TYPE);
-    if (res != ESP_OK){
-        return res;
+// A framesize change resets the sensor window, crop again around the same region
+static int camera_set_framesize(sensor_t *s, framesize_t framesize){
+    int res = s->set_framesize(s, framesize);
+    if (!res && camera_roi.zoom > 100){
+        res = roi_apply(s);
     }
+    return res;
+}
 
-    while (true){
-        int64_t frame_start = esp_timer_get_time();
-        fb = esp_camera_fb_get();
-        if (!fb){
-            Serial.println("Camera capture failed");
-            res = ESP_FAIL;
-        } else {
-            if (fb->format != PIXFORMAT_JPEG){
-              bool jpeg_converted = frame2jpg(fb, 80, &_jpg_buf, &_jpg_buf_len);
-              esp_camera_fb_return(fb);
-              fb = NULL;
-              if (!jpeg_converted){
-                  Serial.println("JPEG compression failed");
-                  res = ESP_FAIL;
-              }
-            } else {
-              _jpg_buf_len = fb->len;
-              _jpg_buf = fb->buf;
-            }
+// Adaptive bitrate: quality first, then framesize, steered by the slowest client
+static abr_config_t abr_config = {
+    .target_fps = ABR_TARGET_FPS,
+    .max_frame_bytes = ABR_MAX_FRAME_BYTES,
+    .min_quality = 10,
+    .max_quality = 40,
+    .quality_step = 5,
+    .framesizes = {FRAMESIZE_VGA, FRAMESIZE_CIF, FRAMESIZE_QVGA, FRAMESIZE_HQVGA, FRAMESIZE_QQVGA},
+    .framesize_count = 5,
+    .degrade_load = 0.9f,
+    .improve_load = 0.5f,
+    .degrade_windows = 1,
+    .improve_windows = 3,
+};
+static portMUX_TYPE abr_mux = portMUX_INITIALIZER_UNLOCKED;
+static abr_state_t abr_state;
+static abr_vote_t abr_round_vote = ABR_IMPROVE;
+static int64_t abr_round_start = 0;
+
+// Re-anchor the controller on the current sensor settings
+static void stream_abr_reset(){
+    sensor_t *s = esp_camera_sensor_get();
+    if (!s){
+        return;
+    }
+    portENTER_CRITICAL(&abr_mux);
+    abr_reset(&abr_config, &abr_state, s->status.framesize, s->status.quality);
+    portEXIT_CRITICAL(&abr_mux);
+}
+
+// Every client votes once per window, the worst vote of each second wins
+static void stream_abr_vote(abr_vote_t vote){
+    bool changed = false;
+    int quality, framesize;
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&abr_mux);
+    if (vote < abr_round_vote){
+        abr_round_vote = vote;
+    }
+    if (now - abr_round_start >= 1000000){
+        changed = abr_step(&abr_config, &abr_state, abr_round_vote);
+        abr_round_vote = ABR_IMPROVE;
+        abr_round_start = now;
+    }
+    quality = abr_quality(&abr_config, &abr_state);
+    framesize = abr_framesize(&abr_config, &abr_state);
+    portEXIT_CRITICAL(&abr_mux);
+
+    if (!changed){
+        return;
+    }
+    sensor_t *s = esp_camera_sensor_get();
+    if (s->pixformat != PIXFORMAT_JPEG){
+        return;
+    }
+    if (s->status.framesize != framesize){
+        camera_set_framesize(s, (framesize_t)framesize);
+    }
+    s->set_quality(s, quality);
+    Serial.printf("ABR: framesize %d, quality %d\n", framesize, quality);
+}
+
+// Per-connection statistics, listed by /streams
+typedef struct {
+    uint32_t frames;      // Frames sent
+    uint64_t bytes;       // Bytes sent
+    uint64_t send_us;     // Time spent sending
+    uint32_t max_send_us; // Slowest frame
+    uint32_t dropped;     // Frames skipped while this client was busy
+    uint32_t age_us;      // Capture to send age of the last frame
+    uint64_t preview_us;  // Time spent decoding and encoding previews
+    float fps;            // Over the last second
+} stream_stats_t;
+
+// One sender task per stream client, all fed by the capture task
+typedef struct {
+    httpd_handle_t server;
+    int fd;
+    char addr[16];              // Client IP address
+    int64_t started;
+    stream_stats_t stats;
+    bool raw;                   // Raw multipart body instead of chunked encoding
+    int scale;                  // 1 for the full stream, 2, 4 or 8 for a preview
+    volatile bool session_open; // Cleared by httpd when the socket is closed
+    volatile bool fd_owned;     // httpd let go of the socket, the sender task closes it
+    volatile bool task_running; // Cleared when the sender task exits
+} stream_client_t;
+
+static portMUX_TYPE stream_clients_mux = portMUX_INITIALIZER_UNLOCKED;
+static stream_client_t stream_clients[MAX_STREAM_CLIENTS];
+
+// Previews cost a decode and an encode per frame, only MAX_PREVIEW_CLIENTS of them are served
+static stream_client_t *stream_client_alloc(int scale){
+    stream_client_t *client = NULL;
+    int previews = 0;
+    portENTER_CRITICAL(&stream_clients_mux);
+    for (int i = 0; i < MAX_STREAM_CLIENTS; i++){
+        if ((stream_clients[i].session_open || stream_clients[i].task_running) && stream_clients[i].scale > 1){
+            previews++;
         }
-        if (res == ESP_OK){
-            size_t hlen = snprintf((char *)part_buf, 64, _STREAM_PART, _jpg_buf_len);
-            res = httpd_resp_send_chunk(req, (const char *)part_buf, hlen);
+    }
+    for (int i = 0; i < MAX_STREAM_CLIENTS && (scale == 1 || previews < MAX_PREVIEW_CLIENTS); i++){
+        if (!stream_clients[i].session_open && !stream_clients[i].task_running){
+            client = &stream_clients[i];
+            client->scale = scale;
+            memset(&client->stats, 0, sizeof(client->stats));
+            client->started = esp_timer_get_time();
+            client->fd = -1; // Set by the handler, no stale number for stream_server_close() to match
+            client->session_open = true;
+            client->fd_owned = false;
+            client->task_running = true;
+            break;
         }
-        if (res == ESP_OK){
-            res = httpd_resp_send_chunk(req, (const char *)_jpg_buf, _jpg_buf_len);
+    }
+    portEXIT_CRITICAL(&stream_clients_mux);
+    return client;
+}
+
+// Called by httpd when the stream socket is closed
+static void stream_client_session_closed(void *ctx){
+    stream_client_t *client = (stream_client_t *)ctx;
+    portENTER_CRITICAL(&stream_clients_mux);
+    client->session_open = false;
+    portEXIT_CRITICAL(&stream_clients_mux);
+}
+
+// close_fn of the stream server. While a sender task runs, the socket stays open
+// and is closed by the task: a closed fd number goes to the next accept(), and
+// the task could otherwise write a stale part into another client's connection.
+static void stream_server_close(httpd_handle_t hd, int fd){
+    bool deferred = false;
+    portENTER_CRITICAL(&stream_clients_mux);
+    for (int i = 0; i < MAX_STREAM_CLIENTS; i++){
+        if (stream_clients[i].task_running && stream_clients[i].fd == fd){
+            stream_clients[i].fd_owned = true;
+            deferred = true;
+            break;
         }
-        if (res == ESP_OK){
-            res = httpd_resp_send_chunk(req, _STREAM_BOUNDARY, strlen(_STREAM_BOUNDARY));
+    }
+    portEXIT_CRITICAL(&stream_clients_mux);
+    if (!deferred){
+        close(fd);
+    }
+}
+
+static bool stream_send_all(int fd, const char *data, size_t len){
+    while (len){
+        int sent = send(fd, data, len, 0);
+        if (sent <= 0){
+            return false;
         }
-        if (fb){
-            esp_camera_fb_return(fb);
-            fb = NULL;
-            _jpg_buf = NULL;
+        data += sent;
+        len -= sent;
+    }
+    return true;
+}
+
+// Same framing as httpd_resp_send_chunk()
+static bool stream_send_chunk(int fd, const char *data, size_t len){
+    char chunk_len[16];
+    size_t hlen = snprintf(chunk_len, sizeof(chunk_len), "%x\r\n", (unsigned)len);
+    return stream_send_all(fd, chunk_len, hlen) &&
+           stream_send_all(fd, data, len) &&
+           stream_send_all(fd, "\r\n", 2);
+}
+
+// Part header, JPEG and boundary in a single write, without copying the JPEG
+static bool stream_send_part(int fd, const char *part, size_t part_len, const uint8_t *jpg, size_t jpg_len){
+    struct iovec iov[3] = {
+        {(void *)part, part_len},
+        {(void *)jpg, jpg_len},
+        {(void *)_STREAM_BOUNDARY, strlen(_STREAM_BOUNDARY)},
+    };
+    struct iovec *v = iov;
+    int count = 3;
+
+    while (count){
+        ssize_t sent = lwip_writev(fd, v, count);
+        if (sent <= 0){
+            return false;
         }
-        else if (_jpg_buf){
-            free(_jpg_buf);
-            _jpg_buf = NULL;
+        // Skip what went out, resume a partial write where it stopped
+        while (count && (size_t)sent >= v->iov_len){
+            sent -= v->iov_len;
+            v++;
+            count--;
         }
-        if (res != ESP_OK){
-            break;
+        if (count){
+            v->iov_base = (char *)v->iov_base + sent;
+            v->iov_len -= sent;
+        }
+    }
+    return true;
+}
+
+static void stream_sender_task(void *arg){
+    stream_client_t *client = (stream_client_t *)arg;
+    char part_buf[128];
+    char resp_hdr[192];
+    uint32_t last_seq = 0;
+    uint32_t last_stream_seq = 0;
+    bool ok;
+
+    stream_stats_t *stats = &client->stats;
+    int64_t fps_time = client->started;
+    uint32_t fps_frames = 0;
+
+    // Throughput report, used to compare raw and chunked framing
+    int64_t report_time = client->started;
+    stream_stats_t report_start = {};
+    int64_t report_age = 0;
+    uint32_t report_max_age = 0;
+
+    abr_window_t abr_window = {};
+    int64_t abr_window_start = client->started;
+
+    stream_preview_t preview = {};
+    preview.scale = client->scale;
+
+    size_t hlen = snprintf(resp_hdr, sizeof(resp_hdr),
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: %s\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "%s\r\n", _STREAM_CONTENT_TYPE, client->raw ? "" : "Transfer-Encoding: chunked\r\n");
+    ok = stream_send_all(client->fd, resp_hdr, hlen) &&
+         broadcaster_subscribe(xTaskGetCurrentTaskHandle());
+
+    while (ok && client->session_open && !client->fd_owned){
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+        shared_frame_t *frame = broadcaster_acquire(last_seq);
+        if (!frame){
+            continue;
+        }
+        uint32_t skipped = last_stream_seq ? frame->stream_seq - last_stream_seq - 1 : 0;
+        last_seq = frame->seq;
+        last_stream_seq = frame->stream_seq;
+        int64_t timestamp = frame->timestamp;
+        uint32_t stream_seq = frame->stream_seq;
+
+        // Previews are made from the shared frame, which can go back to the pool right away
+        const uint8_t *jpg = frame->buf;
+        size_t jpg_len = frame->len;
+        uint32_t preview_us = 0;
+        if (client->scale > 1){
+            bool encoded = preview_encode(&preview, frame, PREVIEW_JPEG_QUALITY);
+            broadcaster_release(frame);
+            frame = NULL;
+            if (!encoded){
+                continue;
+            }
+            jpg = preview.jpg;
+            jpg_len = preview.len;
+            preview_us = preview.decode_us + preview.encode_us;
         }
 
-        // FPS calculation
-        frame_count++;
+        hlen = snprintf(part_buf, sizeof(part_buf), _STREAM_PART, jpg_len, timestamp, stream_seq);
+        int64_t send_start = esp_timer_get_time();
+        if (client->raw){
+            ok = stream_send_part(client->fd, part_buf, hlen, jpg, jpg_len);
+        } else {
+            ok = stream_send_chunk(client->fd, part_buf, hlen) &&
+                 stream_send_chunk(client->fd, (const char *)jpg, jpg_len) &&
+                 stream_send_chunk(client->fd, _STREAM_BOUNDARY, strlen(_STREAM_BOUNDARY));
+        }
         int64_t now = esp_timer_get_time();
-        if (now - last_fps_time > 1000000) { // 1 second
-            camera_fps = frame_count * 1000000.0f / (now - last_fps_time);
-            frame_count = 0;
-            last_fps_time = now;
+        uint32_t age = now - timestamp; // Capture to end of send
+        if (DEBUG){
+            Serial.printf("Stream %s: frame %u age %uus\n", client->addr, stream_seq, age);
+        }
+        uint32_t send_us = now - send_start;
+        if (client->scale == 1){ // Spectators on a preview don't steer the driver's stream
+            abr_sample(&abr_window, jpg_len, send_us);
+        }
+        report_age += age;
+        report_max_age = max(report_max_age, age);
+
+        portENTER_CRITICAL(&stream_clients_mux);
+        stats->frames++;
+        stats->bytes += hlen + jpg_len + strlen(_STREAM_BOUNDARY);
+        stats->send_us += send_us;
+        stats->max_send_us = max(stats->max_send_us, send_us);
+        stats->dropped += skipped;
+        stats->age_us = age;
+        stats->preview_us += preview_us;
+        portEXIT_CRITICAL(&stream_clients_mux);
+        broadcaster_release(frame);
+
+        fps_frames++;
+        if (now - fps_time > 1000000) { // 1 second
+            stats->fps = fps_frames * 1000000.0f / (now - fps_time);
+            fps_frames = 0;
+            fps_time = now;
         }
+        if (client->scale == 1 && now - abr_window_start >= 1000000){
+            stream_abr_vote(abr_evaluate(&abr_config, &abr_window, now - abr_window_start));
+            abr_window_start = now;
+        }
+        if (now - report_time > 5000000) { // 5 seconds
+            float seconds = (now - report_time) / 1000000.0f;
+            uint32_t frames = stats->frames - report_start.frames;
+            Serial.printf("Stream %s (%s): %u B/s, %.1f fps, age avg %ums max %ums\n", client->addr,
+                          client->raw ? "raw" : "chunked", (uint32_t)((stats->bytes - report_start.bytes) / seconds),
+                          frames / seconds, (uint32_t)(frames ? report_age / frames / 1000 : 0), report_max_age / 1000);
+            if (client->scale > 1 && frames){
+                Serial.printf("Preview 1/%d %ux%u: %uus per frame (last decode %uus, encode %uus)\n", client->scale,
+                              preview.width, preview.height, (uint32_t)((stats->preview_us - report_start.preview_us) / frames),
+                              preview.decode_us, preview.encode_us);
+            }
+            report_time = now;
+            report_start = *stats;
+            report_age = 0;
+            report_max_age = 0;
+        }
+    }
+
+    broadcaster_unsubscribe(xTaskGetCurrentTaskHandle());
+    preview_release(&preview);
+    // The fd can't have been reused while this task runs, see stream_server_close().
+    // If httpd already let go of the session, the trigger finds nothing to close.
+    if (!client->fd_owned){
+        httpd_sess_trigger_close(client->server, client->fd);
+    }
+    portENTER_CRITICAL(&stream_clients_mux);
+    bool owned = client->fd_owned;
+    client->task_running = false; // From here on, stream_server_close() closes the fd itself
+    portEXIT_CRITICAL(&stream_clients_mux);
+    if (owned){
+        close(client->fd);
+    }
+    vTaskDelete(NULL);
+}
+
+// Last seconds of the stream as an MJPEG AVI, served on port 81
+static esp_err_t clip_handler(httpd_req_t *req){
+    return clip_send_avi(req);
+}
+
+// Capture first, then send every frame of the burst as one multipart response
+static esp_err_t burst_handler(httpd_req_t *req){
+    char query[64];
+    char param[16];
+    int n = 10;
+    int interval_ms = 0;
+
+    size_t query_len = httpd_req_get_url_query_len(req) + 1;
+    if (query_len > 1 && query_len <= sizeof(query) &&
+        httpd_req_get_url_query_str(req, query, query_len) == ESP_OK){
+        if (httpd_query_key_value(query, "n", param, sizeof(param)) == ESP_OK){
+            n = atoi(param);
+        }
+        if (httpd_query_key_value(query, "interval_ms", param, sizeof(param)) == ESP_OK){
+            interval_ms = min(max(atoi(param), 0), BURST_MAX_INTERVAL_MS);
+        }
+    }
+
+    int count = burst_capture(n, interval_ms);
+    if (!count){
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
     }
 
-    last_frame = 0;
+    char count_hdr[12];
+    snprintf(count_hdr, sizeof(count_hdr), "%d", count);
+    httpd_resp_set_type(req, "multipart/mixed;boundary=" PART_BOUNDARY);
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=burst.mjpeg");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(req, "X-Burst-Frames", count_hdr);
+
+    esp_err_t res = ESP_OK;
+    char part_buf[128];
+    burst_frame_t frame;
+    for (int i = 0; res == ESP_OK && burst_frame(i, &frame); i++){
+        size_t hlen = snprintf(part_buf, sizeof(part_buf), _STREAM_PART, frame.len, frame.timestamp, frame.seq);
+        res = httpd_resp_send_chunk(req, _STREAM_BOUNDARY, strlen(_STREAM_BOUNDARY));
+        if (res == ESP_OK){
+            res = httpd_resp_send_chunk(req, part_buf, hlen);
+        }
+        if (res == ESP_OK){
+            res = httpd_resp_send_chunk(req, (const char *)frame.buf, frame.len);
+        }
+    }
+    if (res == ESP_OK){
+        static const char *end = "\r\n--" PART_BOUNDARY "--\r\n";
+        res = httpd_resp_send_chunk(req, end, strlen(end));
+    }
+    if (res == ESP_OK){
+        res = httpd_resp_send_chunk(req, NULL, 0);
+    }
     return res;
 }
 
+static esp_err_t stream_handler(httpd_req_t *req){
+    char query[32];
+    char param[8];
+    int scale = 1;
+
+    size_t query_len = httpd_req_get_url_query_len(req) + 1;
+    if (query_len > 1 && query_len <= sizeof(query) &&
+        httpd_req_get_url_query_str(req, query, query_len) == ESP_OK &&
+        httpd_query_key_value(query, "scale", param, sizeof(param)) == ESP_OK){
+        scale = preview_parse_scale(param);
+        if (!scale){
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Scale is 1/2, 1/4 or 1/8");
+            return ESP_FAIL;
+        }
+    }
+
+    stream_client_t *client = stream_client_alloc(scale);
+    if (!client){
+        Serial.println("Too many stream clients");
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        return httpd_resp_send(req, NULL, 0);
+    }
+    client->server = req->handle;
+    client->fd = httpd_req_to_sockfd(req);
+    client->raw = stream_raw;
+
+    struct sockaddr_in peer;
+    socklen_t peer_len = sizeof(peer);
+    strcpy(client->addr, "?");
+    if (getpeername(client->fd, (struct sockaddr *)&peer, &peer_len) == 0){
+        inet_ntoa_r(peer.sin_addr, client->addr, sizeof(client->addr));
+    }
+
+    // Frames are written whole, push them out without waiting for the previous ACK
+    int nodelay = 1;
+    setsockopt(client->fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    // Let httpd tell the sender when the socket goes away
+    req->sess_ctx = client;
+    req->free_ctx = stream_client_session_closed;
+
+    // The sender task owns the socket from now on, httpd is free for the next viewer
+    if (xTaskCreatePinnedToCore(stream_sender_task, "stream_tx", 4096, client, 5, NULL, tskNO_AFFINITY) != pdPASS){
+        Serial.println("Stream task creation failed");
+        portENTER_CRITICAL(&stream_clients_mux);
+        client->task_running = false;
+        portEXIT_CRITICAL(&stream_clients_mux);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+// List the stream clients and their statistics
+static esp_err_t streams_handler(httpd_req_t *req){
+    static char json_response[320 * MAX_STREAM_CLIENTS + 64];
+    char *p = json_response;
+    char *end = json_response + sizeof(json_response);
+    int64_t now = esp_timer_get_time();
+    bool first = true;
+
+    p += snprintf(p, end - p, "{\"capture_fps\":%.1f,\"streams\":[", camera_fps);
+    for (int i = 0; i < MAX_STREAM_CLIENTS; i++){
+        stream_client_t *client = &stream_clients[i];
+        portENTER_CRITICAL(&stream_clients_mux);
+        bool active = client->session_open && client->task_running;
+        stream_stats_t stats = client->stats;
+        portEXIT_CRITICAL(&stream_clients_mux);
+        if (!active){
+            continue;
+        }
+        p += snprintf(p, end - p,
+            "%s{\"addr\":\"%s\",\"raw\":%s,\"scale\":%d,\"uptime_s\":%u,\"frames\":%u,\"bytes\":%llu,"
+            "\"fps\":%.1f,\"avg_send_ms\":%.1f,\"max_send_ms\":%.1f,\"dropped\":%u,\"age_ms\":%.1f,\"avg_preview_ms\":%.1f}",
+            first ? "" : ",", client->addr, client->raw ? "true" : "false", client->scale, (uint32_t)((now - client->started) / 1000000),
+            stats.frames, stats.bytes, stats.fps, stats.frames ? stats.send_us / 1000.0f / stats.frames : 0.0f,
+            stats.max_send_us / 1000.0f, stats.dropped, stats.age_us / 1000.0f,
+            stats.frames ? stats.preview_us / 1000.0f / stats.frames : 0.0f);
+        first = false;
+    }
+    snprintf(p, end - p, "]}");
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    return httpd_resp_send(req, json_response, strlen(json_response));
+}
+
+// Motor control task state and loop timing, the statistics restart on every request
+static esp_err_t motor_handler(httpd_req_t *req){
+    char json_response[384];
+    int x, y, duty_right, duty_left;
+    int32_t age_ms;
+    motor_stats_t stats;
+    motor_state(&x, &y, &age_ms, &duty_right, &duty_left);
+    motor_stats(&stats, true);
+
+    snprintf(json_response, sizeof(json_response),
+        "{\"rate_hz\":%d,\"timeout_ms\":%d,\"x\":%d,\"y\":%d,\"command_age_ms\":%d,"
+        "\"duty_right\":%d,\"duty_left\":%d,\"loops\":%u,\"period_min_us\":%u,\"period_max_us\":%u,"
+        "\"jitter_avg_us\":%u,\"jitter_max_us\":%u,\"overruns\":%u,\"deadman_stops\":%u}",
+        MOTOR_CONTROL_HZ, MOTOR_TIMEOUT_MS, x, y, (int)age_ms, duty_right, duty_left,
+        stats.loops, stats.period_min_us, stats.period_max_us, stats.jitter_avg_us,
+        stats.jitter_max_us, stats.overruns, stats.deadman_stops);
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    return httpd_resp_send(req, json_response, strlen(json_response));
+}
+
 static esp_err_t cmd_handler(httpd_req_t *req){
     char *buf;
     size_t buf_len;
@@ -223,11 +866,29 @@ static esp_err_t cmd_handler(httpd_req_t *req){
     int res = 0;
 
     if (!strcmp(variable, "framesize")){
+        // The camera buffers were sized at init (QVGA in DRAM in low latency mode)
+        if (val > broadcaster_max_framesize()){
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Framesize above the camera buffers");
+            return ESP_FAIL;
+        }
         if (s->pixformat == PIXFORMAT_JPEG)
-            res = s->set_framesize(s, (framesize_t)val);
+            res = camera_set_framesize(s, (framesize_t)val);
+        stream_abr_reset();
     }
-    else if (!strcmp(variable, "quality"))
+    else if (!strcmp(variable, "quality")){
         res = s->set_quality(s, val);
+        stream_abr_reset();
+    }
+    else if (!strcmp(variable, "target_fps")){
+        portENTER_CRITICAL(&abr_mux);
+        abr_config.target_fps = val;
+        portEXIT_CRITICAL(&abr_mux);
+    }
+    else if (!strcmp(variable, "max_frame_bytes")){
+        portENTER_CRITICAL(&abr_mux);
+        abr_config.max_frame_bytes = val > 0 ? val : 0;
+        portEXIT_CRITICAL(&abr_mux);
+    }
     else if (!strcmp(variable, "contrast"))
         res = s->set_contrast(s, val);
     else if (!strcmp(variable, "brightness"))
@@ -272,6 +933,14 @@ static esp_err_t cmd_handler(httpd_req_t *req){
         res = s->set_wb_mode(s, val);
     else if (!strcmp(variable, "ae_level"))
         res = s->set_ae_level(s, val);
+    else if (!strcmp(variable, "roi")){
+        // val=zoom[,center_x,center_y], zoom in percent, center in permille
+        res = roi_parse(value, &camera_roi) ? roi_apply(s) : -1;
+    }
+    else if (!strcmp(variable, "raw_quality"))
+        broadcaster_set_raw_quality(val);
+    else if (!strcmp(variable, "stream_raw"))
+        stream_raw = val; // Applies to the next stream connection
     else {
         res = -1;
     }
@@ -324,121 +993,64 @@ static esp_err_t status_handler(httpd_req_t *req)
     return httpd_resp_send(req, json_response, strlen(json_response));
 }
 
+// Strong ETag of a constant asset, FNV-1a of its bytes
+static void http_etag(const uint8_t *data, size_t len, char *etag, size_t etag_size){
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++){
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    snprintf(etag, etag_size, "\"%08x%04x\"", (unsigned)hash, (unsigned)(len & 0xFFFF));
+}
+
+// Set the validator and cache headers, answer 304 if the client already has this version
+static bool http_not_modified(httpd_req_t *req, const char *etag, const char *cache_control){
+    char if_none_match[48];
+    httpd_resp_set_hdr(req, "ETag", etag);
+    httpd_resp_set_hdr(req, "Cache-Control", cache_control);
+    if (httpd_req_get_hdr_value_str(req, "If-None-Match", if_none_match, sizeof(if_none_match)) == ESP_OK &&
+        strstr(if_none_match, etag)){
+        httpd_resp_set_status(req, "304 Not Modified");
+        httpd_resp_send(req, NULL, 0);
+        return true;
+    }
+    return false;
+}
+
+// Sensor tuning page (esp32-camera example UI), sent gzipped straight from flash
+static esp_err_t tune_handler(httpd_req_t *req){
+    static char etag_ov2640[16];
+    static char etag_ov3660[16];
+
+    sensor_t *s = esp_camera_sensor_get();
+    bool ov3660 = s && s->id.PID == OV3660_PID;
+    const uint8_t *page = ov3660 ? index_ov3660_html_gz : index_ov2640_html_gz;
+    size_t page_len = ov3660 ? index_ov3660_html_gz_len : index_ov2640_html_gz_len;
+    char *etag = ov3660 ? etag_ov3660 : etag_ov2640;
+    if (!etag[0]){
+        http_etag(page, page_len, etag, sizeof(etag_ov2640));
+    }
+
+    if (http_not_modified(req, etag, "public, max-age=604800")){
+        return ESP_OK;
+    }
+    httpd_resp_set_type(req, "text/html");
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    return httpd_resp_send(req, (const char *)page, page_len);
+}
+
+// Driving page, gzipped at build time from web/index.html (scripts/embed_web.py)
 static esp_err_t index_handler(httpd_req_t *req) {
+    static char etag[16];
+    if (!etag[0]){
+        http_etag(index_html_gz, index_html_gz_len, etag, sizeof(etag));
+    }
+    // Revalidated on every load, the page changes with each firmware
+    if (http_not_modified(req, etag, "no-cache")){
+        return ESP_OK;
+    }
     httpd_resp_set_type(req, "text/html");
-    String page = "";
-    // Meta tag and viewport settings
-    page += "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0, maximum-scale=1.0, user-scalable=0\">\n";
-
-    // CSS to set the background color and button styles
-    page += "<style>";
-    page += "body { background-color: #FFFFFF; }";  // Change the background color here
-    page += "button { color: white; margin: 5px; }";  // Set the text color inside buttons to white and add margin
-    page += "p.bottom-text { text-align: left; margin: 2px 0; }";  // Align bottom text to the left and reduce margin
-    page += ".bottom-container { display: flex; align-items: center; justify-content: center; }";  // Flex container for image and text, align items to the center
-    page += ".bottom-container img { margin-right: 10px; }";  // Margin for the image
-    page += ".bottom-container div { text-align: left; }";  // Align text to the left within the container
-    page += "</style>";
-    
-    // XMLHttpRequest for sending GET requests
-    page += "<script>var xhttp = new XMLHttpRequest();</script>";
-    page += "<script>function getsend(arg) { xhttp.open('GET', arg +'?' + new Date().getTime(), true); xhttp.send() }</script>";
-    
-    // Image stream (adjust to your actual stream URL)
-    page += "<body onload=\"document.getElementById('stream').src=document.location.origin+':81/stream';\">";
-    page += "<div style='position:relative; display:inline-block; text-align:left;'>";
-    page += "  <img id='stream' src='' style='width:400px;' crossorigin='anonymous'>";
-    page += "  <div id='fpsOverlay' style='position:absolute; top:10px; left:10px; background:rgba(0,0,0,0.5); color:#fff; padding:4px 10px; border-radius:8px; font-size:18px; font-family:monospace;'>FPS: <span id='fpsValue'>0.0</span></div>";
-    page += "</div>";
-
-    // FPS display with span for dynamic updating
-    page += "<script>";
-    page += "  function updateFPS() {";
-    page += "    var xhttp = new XMLHttpRequest();";
-    page += "    xhttp.onreadystatechange = function() {";
-    page += "      if (this.readyState == 4 && this.status == 200) {";
-    page += "        document.getElementById('fpsValue').innerText = this.responseText;";
-    page += "      }";
-    page += "    };";
-    page += "    xhttp.open('GET', '/fps', true);";
-    page += "    xhttp.send();";
-    page += "  }";
-    page += "  setInterval(updateFPS, 1000);";
-    page += "  updateFPS();";
-    page += "</script>";
-
-    // Include joy.min.js library
-    page += "<script src=\"/joy.min.js\"></script>";
-
-    // Joystick container
-    page += "<div id=\"joystickDiv\" style=\"width: 200px; height: 200px; margin: 0 auto;\"></div>";
-
-    // JavaScript for joystick functionality
-    page += "<script>";
-    page += "  var JoyStick = new JoyStick('joystickDiv', {";
-    page += "    'title': 'joystick',";
-    page += "    'width': 200,";
-    page += "    'height': 200,";
-    page += "    'internalFillColor': ' #82AE32',";
-    page += "    'internalStrokeColor': ' #085C4D',";
-    page += "    'externalStrokeColor': ' #085C4D'";
-    page += "  });";
-
-    // Monitor joystick position and send commands
-    page += "  setInterval(function() {";
-    page += "    let x = JoyStick.GetX();"; // Get X-axis value
-    page += "    let y = JoyStick.GetY();"; // Get Y-axis value";
-    page += "    let xhttp = new XMLHttpRequest();";
-    page += "    xhttp.open('GET', '/joycontrol?x=' + x + '&y=' + y, true);";
-    page += "    xhttp.send();";
-    page += "  }, 250);"; // Check joystick position every 250ms
-    page += "</script>";
-
-    // Single LED toggle button
-    page += "<p align=center>";
-    page += "<button id='ledButton' style='background-color: #808080;width:140px;height:40px' onclick='toggleLED()'><b>Lumi&#232res</b></button>";
-    page += "</p>";
-
-    // Battery display with span for dynamic updating
-    page += "<p style='text-align:center; color: #5087f5;'>Batterie = <span id='batteryValue'>0</span>%</p>";
-
-    // JavaScript to fetch and update battery percentage every 30 seconds
-    page += "<script>";
-    page += "  function updateBattery() {";
-    page += "    let xhttp = new XMLHttpRequest();";
-    page += "    xhttp.onreadystatechange = function() {";
-    page += "      if (this.readyState == 4 && this.status == 200) {";
-    page += "        document.getElementById('batteryValue').innerText = this.responseText;";
-    page += "      }";
-    page += "    };";
-    page += "    xhttp.open('GET', '/battery', true);";
-    page += "    xhttp.send();";
-    page += "  }";
-    page += "  setInterval(updateBattery, 30000);"; // Update every 30 seconds
-    page += "  updateBattery();"; // Initial call to update battery percentage immediately
-    page += "</script>";
-
-    // JavaScript function to toggle the LED
-    page += "<script>";
-    page += "var ledState = false;";
-    page += "function toggleLED() {";
-    page += "  ledState = !ledState;";
-    page += "  getsend('/toggle_led');";
-    page += "  document.getElementById('ledButton').style.backgroundColor = ledState ? ' #085C4D' : ' #808080';";
-    page += "}";
-    page += "</script>";
-
-    // Add image and text at the bottom of the page
-    page += "<div class='bottom-container'>";
-    page += "<img src='/logo.png' style='width:70px;height:70px;'>";
-    page += "<div>";
-    page += "<p class='bottom-text' style='color: #085C4D;'>C&#233gep de Sherbrooke</p>";
-    page += "<p class='bottom-text' style='color: #085C4D;'>Technologies du g&#233nie &#233lectrique</p>";
-    page += "<p class='bottom-text' style='color: #FF640A; font-size: 17px; font-weight: bold;'>&#201lectronique Programmable</p>";  // Change the color, size, and weight here
-    page += "</div>";
-    page += "</div>";
-    
-    return httpd_resp_send(req, &page[0], strlen(&page[0]));
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    return httpd_resp_send(req, (const char *)index_html_gz, index_html_gz_len);
 }
 
 // Define the battery handler
@@ -460,57 +1072,181 @@ static esp_err_t toggle_led_handler(httpd_req_t *req){
   return httpd_resp_send(req, "OK", 2);
 }
 
-// Handler to serve the image file
-static esp_err_t image_handler(httpd_req_t *req) {
-  File file = LittleFS.open("/logo.png", "r");
-  if (!file) {
-    Serial.println("Did not find the image file");
-    httpd_resp_send_404(req);
-    return ESP_FAIL;
-  }
-  httpd_resp_set_type(req, "image/png");
-  
-  // Read the file and send the data in chunks
-  size_t fileSize = file.size();
-  uint8_t *buffer = (uint8_t *)malloc(fileSize);
-  if (buffer) {
-    file.read(buffer, fileSize);
-    httpd_resp_send(req, (const char *)buffer, fileSize);
-    free(buffer);
-  } else {
-    httpd_resp_send_500(req);
-    file.close();
-    return ESP_FAIL;
-  }
-  file.close();
-  return ESP_OK;
+// Static files for every other path: the flash asset bundle first, then LittleFS.
+// Files are streamed in STATIC_CHUNK_SIZE pieces, nothing is allocated per request.
+static const struct {
+    const char *ext;
+    const char *type;
+} mime_types[] = {
+    {".html", "text/html"},
+    {".htm", "text/html"},
+    {".js", "application/javascript"},
+    {".css", "text/css"},
+    {".json", "application/json"},
+    {".png", "image/png"},
+    {".jpg", "image/jpeg"},
+    {".jpeg", "image/jpeg"},
+    {".gif", "image/gif"},
+    {".svg", "image/svg+xml"},
+    {".ico", "image/x-icon"},
+    {".txt", "text/plain"},
+    {".woff2", "font/woff2"},
+    {".avi", "video/x-msvideo"},
+};
+
+static const char *mime_type(const char *path){
+    size_t len = strlen(path);
+    for (size_t i = 0; i < sizeof(mime_types) / sizeof(mime_types[0]); i++){
+        size_t ext_len = strlen(mime_types[i].ext);
+        if (len >= ext_len && !strcasecmp(path + len - ext_len, mime_types[i].ext)){
+            return mime_types[i].type;
+        }
+    }
+    return "application/octet-stream";
 }
 
-static esp_err_t joyjs_handler(httpd_req_t *req) {
-    File file = LittleFS.open("/joy.min.js", "r");
-    if (!file) {
-        Serial.println("Failed to open joy.min.js");
-        httpd_resp_send_404(req);
-        return ESP_FAIL;
+// Single "bytes=" range, false if the header asks for something we can't serve
+static bool http_range(httpd_req_t *req, size_t size, size_t *start, size_t *end, bool *partial){
+    char range[48];
+    *start = 0;
+    *end = size ? size - 1 : 0;
+    *partial = false;
+    if (httpd_req_get_hdr_value_str(req, "Range", range, sizeof(range)) != ESP_OK){
+        return true;
+    }
+    if (strncmp(range, "bytes=", 6) || strchr(range, ',')){
+        return true; // Unknown unit or several ranges, send the whole file
+    }
+    char *p = range + 6;
+    char *dash = strchr(p, '-');
+    if (!dash || !size){
+        return false;
+    }
+    if (p == dash){
+        // Suffix: the last n bytes
+        size_t n = strtoul(dash + 1, NULL, 10);
+        if (!n){
+            return false;
+        }
+        *start = n < size ? size - n : 0;
+    } else {
+        *start = strtoul(p, NULL, 10);
+        if (dash[1]){
+            *end = min((size_t)strtoul(dash + 1, NULL, 10), size - 1);
+        }
     }
+    if (*start > *end){
+        return false;
+    }
+    *partial = true;
+    return true;
+}
+
+static char static_chunk[STATIC_CHUNK_SIZE]; // The port 80 server handles one request at a time
 
-    httpd_resp_set_type(req, "application/javascript");
+static esp_err_t static_handler(httpd_req_t *req){
+    char path[64];
+    char etag[24];
+    char accept[64];
+    char content_range[48];
+    asset_t asset;
+    File file;
+    size_t size;
 
-    // Read the file and send the data in chunks
-    size_t fileSize = file.size();
-    uint8_t *buffer = (uint8_t *)malloc(fileSize);
-    if (buffer) {
-        file.read(buffer, fileSize);
-        httpd_resp_send(req, (const char *)buffer, fileSize);
-        free(buffer);
+    size_t path_len = strcspn(req->uri, "?#");
+    if (path_len >= sizeof(path) - 3 || strstr(req->uri, "..")){
+        httpd_resp_send_404(req);
+        return ESP_FAIL;
+    }
+    memcpy(path, req->uri, path_len);
+    path[path_len] = 0;
+    const char *type = mime_type(path);
+    bool gzip = false;
+    bool accepts_gzip = httpd_req_get_hdr_value_str(req, "Accept-Encoding", accept, sizeof(accept)) == ESP_OK &&
+                        strstr(accept, "gzip");
+
+    // The bundle only has the gzipped copy of a compressed asset, other clients get the LittleFS file
+    bool in_bundle = asset_find(path, &asset);
+    bool bundled = in_bundle && (!asset.gzip || accepts_gzip);
+    if (bundled){
+        size = asset.size;
+        gzip = asset.gzip;
+        snprintf(etag, sizeof(etag), "\"%08x\"", (unsigned)asset.etag);
     } else {
-        httpd_resp_send_500(req);
+        // Prefer the gzipped sibling when the client takes it
+        if (accepts_gzip){
+            strcat(path, ".gz");
+            gzip = LittleFS.exists(path);
+            if (gzip){
+                file = LittleFS.open(path, "r");
+            }
+            path[path_len] = 0;
+        }
+        if (!file && LittleFS.exists(path)){
+            file = LittleFS.open(path, "r");
+        }
+        if (!file || file.isDirectory()){
+            file.close();
+            if (in_bundle){
+                httpd_resp_set_status(req, "406 Not Acceptable");
+                httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+                httpd_resp_set_type(req, "text/plain");
+                static const char *msg = "Only available gzipped";
+                return httpd_resp_send(req, msg, strlen(msg));
+            }
+            httpd_resp_send_404(req);
+            return ESP_FAIL;
+        }
+        size = file.size();
+        snprintf(etag, sizeof(etag), "\"%x-%x%s\"", (unsigned)size, (unsigned)file.getLastWrite(), gzip ? "-gz" : "");
+    }
+
+    // Caches must not hand gzip to a client that didn't ask for it, 304s included
+    httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+    // Pages are checked on every load, the rest is kept for a day
+    if (http_not_modified(req, etag, strcmp(type, "text/html") ? "public, max-age=86400" : "no-cache")){
         file.close();
-        return ESP_FAIL;
+        return ESP_OK;
+    }
+    size_t start, end;
+    bool partial;
+    if (!http_range(req, size, &start, &end, &partial)){
+        snprintf(content_range, sizeof(content_range), "bytes */%u", (unsigned)size);
+        httpd_resp_set_status(req, "416 Range Not Satisfiable");
+        httpd_resp_set_hdr(req, "Content-Range", content_range);
+        file.close();
+        return httpd_resp_send(req, NULL, 0);
+    }
+    httpd_resp_set_type(req, type);
+    httpd_resp_set_hdr(req, "Accept-Ranges", "bytes");
+    if (gzip){
+        httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    }
+    if (partial){
+        snprintf(content_range, sizeof(content_range), "bytes %u-%u/%u", (unsigned)start, (unsigned)end, (unsigned)size);
+        httpd_resp_set_status(req, "206 Partial Content");
+        httpd_resp_set_hdr(req, "Content-Range", content_range);
+    }
+
+    esp_err_t res = ESP_OK;
+    if (!bundled && start){
+        file.seek(start);
+    }
+    for (size_t pos = start; size && pos <= end && res == ESP_OK; pos += STATIC_CHUNK_SIZE){
+        size_t len = min((size_t)STATIC_CHUNK_SIZE, end + 1 - pos);
+        if (bundled){
+            res = httpd_resp_send_chunk(req, (const char *)asset.data + pos, len); // Straight from mapped flash
+        } else if (file.read((uint8_t *)static_chunk, len) == len){
+            res = httpd_resp_send_chunk(req, static_chunk, len);
+        } else {
+            res = ESP_FAIL;
+        }
     }
     file.close();
-    Serial.println("Opened joy.min.js");
-    return ESP_OK;
+    if (res == ESP_OK){
+        res = httpd_resp_send_chunk(req, NULL, 0);
+    }
+    return res;
 }
 
 esp_err_t control_handler(httpd_req_t *req) {
@@ -535,36 +1271,73 @@ esp_err_t control_handler(httpd_req_t *req) {
         free(buf);
     }
 
-    // Disable motors if both X and Y are below 30
-    if (abs(x) < 10 && abs(y) < 10) {
-        Serial.println("X and Y below threshold, stopping motors");
-        rcCar_stop();
-        httpd_resp_send(req, "OK", 2);
-        return ESP_OK;
-    }
-
-    // Reduce speed when turning
-    float turn_factor = 1.0f - pow(abs(x) / 100.0f, 2.0f); // Use a smoother non-linear scaling
-    turn_factor = max(0.9f, min(1.0f, turn_factor)); // Clamp turn_factor to a minimum of 90% and a maximum of 100%
+    motor_set(x, y);
 
-    // Map joystick values to PWM duty cycle (-100 to 100)
-    int adjusted_x = (y < -10) ? -x : x; // Adjust x for backward movement
+    // Send response
+    httpd_resp_send(req, "OK", 2);
+    return ESP_OK;
+}
 
-    // Apply a weighted adjustment to reduce sharpness
-    float weight = 0.5f; // Reduce the influence of x on turning
-    int duty_cycle_right = y - (adjusted_x * weight); // Combine forward/backward (y) and turning (x) for the right motor
-    int duty_cycle_left = y + (adjusted_x * weight);  // Combine forward/backward (y) and turning (x) for the left motor
+#if CONFIG_HTTPD_WS_SUPPORT
+// Per connection, each page numbers its own joystick frames
+typedef struct {
+    uint16_t last_seq; // Newest joystick frame applied
+    bool have_seq;     // False until the first frame
+} ws_session_t;
+
+// Joystick frames on a persistent WebSocket, see control_protocol.h
+static esp_err_t ws_handler(httpd_req_t *req) {
+    if (req->method == HTTP_GET) {
+        // Handshake done, the session keeps the sequence until the socket closes
+        ws_session_t *session = (ws_session_t *)calloc(1, sizeof(ws_session_t));
+        if (!session) {
+            return ESP_ERR_NO_MEM;
+        }
+        req->sess_ctx = session;
+        req->free_ctx = free;
+        Serial.printf("Control WebSocket opened (socket %d)\n", httpd_req_to_sockfd(req));
+        return ESP_OK;
+    }
 
-    // Apply turn_factor to smooth the turning effect
-    duty_cycle_right *= turn_factor;
-    duty_cycle_left *= turn_factor;
+    joy_frame_t joy;
+    httpd_ws_frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    esp_err_t res = httpd_ws_recv_frame(req, &frame, 0); // Length only
+    if (res != ESP_OK) {
+        return res;
+    }
+    if (frame.type != HTTPD_WS_TYPE_BINARY || frame.len != sizeof(joy)) {
+        Serial.printf("Control WebSocket: unexpected frame type %d, %u bytes\n", frame.type, (unsigned)frame.len);
+        return ESP_FAIL; // Closes the socket, the page falls back to /joycontrol
+    }
+    frame.payload = (uint8_t *)&joy;
+    res = httpd_ws_recv_frame(req, &frame, sizeof(joy));
+    if (res != ESP_OK) {
+        return res;
+    }
 
-    // Clamp duty cycles to the range -100 to 100
-    duty_cycle_right = max(-100, min(100, duty_cycle_right));
-    duty_cycle_left = max(-100, min(100, duty_cycle_left));
+    // Only the newest frame of this page drives, a page reopening the socket restarts the sequence
+    ws_session_t *session = (ws_session_t *)req->sess_ctx;
+    if (!session) {
+        return ESP_FAIL;
+    }
+    if (session->have_seq && !joy_seq_newer(joy.seq, session->last_seq)) {
+        return ESP_OK;
+    }
+    session->have_seq = true;
+    session->last_seq = joy.seq;
 
-    Serial.printf("Duty Cycle Right: %d, Left: %d\n", duty_cycle_right, duty_cycle_left);
+    if (DEBUG) {
+        Serial.printf("Joystick #%u x=%d y=%d age=%dms\n", (unsigned)joy.seq, joy.x, joy.y,
+                      (int)((uint32_t)(esp_timer_get_time() / 1000) - joy.client_ms));
+    }
+    motor_set(joy.x, joy.y);
+    return ESP_OK;
+}
+#endif
 
+// Drive the MCPWM outputs, duty cycles in -100..100 (motor_control.cpp mixes the joystick)
+void rcCar_set_duty(int duty_cycle_right, int duty_cycle_left) {
     // Set motor directions and duty cycles
     if (duty_cycle_right > 0) {
         mcpwm_set_duty(MCPWM_UNIT_0, MCPWM_TIMER_0, MCPWM_OPR_A, duty_cycle_right); // Right motor forward
@@ -581,10 +1354,15 @@ esp_err_t control_handler(httpd_req_t *req) {
         mcpwm_set_duty(MCPWM_UNIT_0, MCPWM_TIMER_1, MCPWM_OPR_A, -duty_cycle_left); // Stop left motor forward
         mcpwm_set_duty(MCPWM_UNIT_0, MCPWM_TIMER_1, MCPWM_OPR_B, 0); // Left motor backward
     }
+}
 
-    // Send response
-    httpd_resp_send(req, "OK", 2);
-    return ESP_OK;
+// Device clock for the page's latency measurement, in microseconds
+esp_err_t time_handler(httpd_req_t *req) {
+    char timeStr[24];
+    snprintf(timeStr, sizeof(timeStr), "%lld", esp_timer_get_time());
+    httpd_resp_set_type(req, "text/plain");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+    return httpd_resp_send(req, timeStr, strlen(timeStr));
 }
 
 esp_err_t fps_handler(httpd_req_t *req) {
@@ -598,6 +1376,7 @@ esp_err_t fps_handler(httpd_req_t *req) {
 void startCameraServer() {
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.max_uri_handlers = 32; // Increase the maximum number of URI handlers
+  config.uri_match_fn = httpd_uri_match_wildcard; // For the static file fallback
 
   httpd_uri_t battery_uri = {
     .uri       = "/battery",
@@ -627,6 +1406,13 @@ void startCameraServer() {
     .user_ctx  = NULL
   };
 
+  httpd_uri_t tune_uri = {
+    .uri       = "/tune",
+    .method    = HTTP_GET,
+    .handler   = tune_handler,
+    .user_ctx  = NULL
+  };
+
   httpd_uri_t cmd_uri = {
     .uri       = "/control",
     .method    = HTTP_GET,
@@ -641,6 +1427,16 @@ void startCameraServer() {
     .user_ctx  = NULL
 };
 
+#if CONFIG_HTTPD_WS_SUPPORT
+  httpd_uri_t ws_uri = {
+    .uri          = "/ws",
+    .method       = HTTP_GET,
+    .handler      = ws_handler,
+    .user_ctx     = NULL,
+    .is_websocket = true
+  };
+#endif
+
   httpd_uri_t capture_uri = {
     .uri       = "/capture",
     .method    = HTTP_GET,
@@ -655,19 +1451,12 @@ void startCameraServer() {
     .user_ctx  = NULL
   };
 
-  httpd_uri_t image_uri = {
-    .uri       = "/logo.png",
-    .method    = HTTP_GET,
-    .handler   = image_handler,
-    .user_ctx  = NULL
-  };
-
-  httpd_uri_t joyjs_uri = {
-    .uri       = "/joy.min.js",
-    .method    = HTTP_GET,
-    .handler   = joyjs_handler,
-    .user_ctx  = NULL
-  };
+  httpd_uri_t static_uri = {
+        .uri       = "/*",
+        .method    = HTTP_GET,
+        .handler   = static_handler,
+        .user_ctx  = NULL
+    };
 
   httpd_uri_t fps_uri = {
         .uri       = "/fps",
@@ -676,25 +1465,91 @@ void startCameraServer() {
         .user_ctx  = NULL
     };
 
+  httpd_uri_t clip_uri = {
+        .uri       = "/clip",
+        .method    = HTTP_GET,
+        .handler   = clip_handler,
+        .user_ctx  = NULL
+    };
+
+  httpd_uri_t clip_redirect_uri = {
+        .uri       = "/clip",
+        .method    = HTTP_GET,
+        .handler   = media_redirect_handler,
+        .user_ctx  = NULL
+    };
+
+  httpd_uri_t burst_uri = {
+        .uri       = "/burst",
+        .method    = HTTP_GET,
+        .handler   = burst_handler,
+        .user_ctx  = NULL
+    };
+
+  httpd_uri_t burst_redirect_uri = {
+        .uri       = "/burst",
+        .method    = HTTP_GET,
+        .handler   = media_redirect_handler,
+        .user_ctx  = NULL
+    };
+
+  httpd_uri_t streams_uri = {
+        .uri       = "/streams",
+        .method    = HTTP_GET,
+        .handler   = streams_handler,
+        .user_ctx  = NULL
+    };
+
+  httpd_uri_t motor_uri = {
+        .uri       = "/motor",
+        .method    = HTTP_GET,
+        .handler   = motor_handler,
+        .user_ctx  = NULL
+    };
+
+  httpd_uri_t time_uri = {
+        .uri       = "/time",
+        .method    = HTTP_GET,
+        .handler   = time_handler,
+        .user_ctx  = NULL
+    };
+
   Serial.printf("Starting web server on port: '%d'\n", config.server_port);
   if (httpd_start(&camera_httpd, &config) == ESP_OK) {
     httpd_register_uri_handler(camera_httpd, &index_uri);
     httpd_register_uri_handler(camera_httpd, &battery_uri);
     httpd_register_uri_handler(camera_httpd, &led_uri);
-    httpd_register_uri_handler(camera_httpd, &image_uri);
     httpd_register_uri_handler(camera_httpd, &status_uri);
     httpd_register_uri_handler(camera_httpd, &cmd_uri);
+    httpd_register_uri_handler(camera_httpd, &tune_uri);
     httpd_register_uri_handler(camera_httpd, &capture_uri);
-    httpd_register_uri_handler(camera_httpd, &joyjs_uri);
     httpd_register_uri_handler(camera_httpd, &joycontrol_uri);
+#if CONFIG_HTTPD_WS_SUPPORT
+    httpd_register_uri_handler(camera_httpd, &ws_uri);
+#endif
     httpd_register_uri_handler(camera_httpd, &fps_uri);
+    httpd_register_uri_handler(camera_httpd, &time_uri);
+    httpd_register_uri_handler(camera_httpd, &streams_uri);
+    httpd_register_uri_handler(camera_httpd, &motor_uri);
+    httpd_register_uri_handler(camera_httpd, &clip_redirect_uri);
+    httpd_register_uri_handler(camera_httpd, &burst_redirect_uri);
+    httpd_register_uri_handler(camera_httpd, &static_uri); // Last, matches every path
   }
   config.server_port += 1;
   config.ctrl_port += 1;
+  config.max_open_sockets = MAX_STREAM_CLIENTS + 1;
+  config.close_fn = stream_server_close;
+  stream_abr_reset();
+  preview_init();
   Serial.printf("Starting stream server on port: '%d'\n", config.server_port);
   if (httpd_start(&stream_httpd, &config) == ESP_OK) {
     httpd_register_uri_handler(stream_httpd, &stream_uri);
+    httpd_register_uri_handler(stream_httpd, &clip_uri);
+    httpd_register_uri_handler(stream_httpd, &burst_uri);
+    httpd_register_uri_handler(stream_httpd, &capture_uri); // Photo mode, redirected from port 80
   }
+
+  udp_control_start(UDP_CONTROL_PORT); // Scripted driving, see tools/udp_drive.cpp
 }
 
 void rcCar_setup() {
@@ -718,6 +1573,7 @@ void rcCar_setup() {
 
   // Stop the motors initially
   rcCar_stop();
+  motor_control_start(); // Applies the joystick commands, stops the car if they stop coming
 
   // Initialize the lights pin
   pinMode(LIGHTS_PIN, OUTPUT);
@@ -730,6 +1586,7 @@ void rcCar_setup() {
   pixels.show();
 
   initLITTLEFS();
+  asset_bundle_init();
   updateBatteryPercentage();
 }
 
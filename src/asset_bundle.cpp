@@ -0,0 +1,95 @@
+/*
+  ESP32CAM rcCar
+  Static assets memory mapped from their own flash partition
+*/
+
+#include "asset_bundle.h"
+#include "esp_partition.h"
+#include "esp_spi_flash.h"
+#include "Arduino.h"
+
+#define ASSET_MAGIC "RCAB"
+#define ASSET_VERSION 1
+#define ASSET_PATH_SIZE 48
+#define ASSET_FLAG_GZIP 1
+#define ASSET_PARTITION_SUBTYPE 0x40
+
+// Same layout as scripts/pack_assets.py
+typedef struct __attribute__((packed)) {
+    char magic[4];
+    uint16_t version;
+    uint16_t count;
+    uint32_t size;
+} asset_header_t;
+
+typedef struct __attribute__((packed)) {
+    char path[ASSET_PATH_SIZE];
+    uint32_t offset;
+    uint32_t size;
+    uint32_t flags;
+    uint32_t etag;
+} asset_entry_t;
+
+static const uint8_t *bundle = NULL;
+static const asset_entry_t *entries = NULL;
+static int entry_count = 0;
+static size_t bundle_size = 0;
+
+bool asset_bundle_init(){
+    if (bundle){
+        return true;
+    }
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+        (esp_partition_subtype_t)ASSET_PARTITION_SUBTYPE, "assets");
+    if (!partition){
+        Serial.println("No assets partition");
+        return false;
+    }
+    asset_header_t header;
+    if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK ||
+        memcmp(header.magic, ASSET_MAGIC, 4) || header.version != ASSET_VERSION ||
+        header.size > partition->size || sizeof(header) + header.count * sizeof(asset_entry_t) > header.size){
+        Serial.println("No asset bundle, run pio run -t uploadassets");
+        return false;
+    }
+
+    // Only the bundle is mapped, the MMU maps 64KB pages
+    const void *ptr;
+    spi_flash_mmap_handle_t handle;
+    if (esp_partition_mmap(partition, 0, header.size, SPI_FLASH_MMAP_DATA, &ptr, &handle) != ESP_OK){
+        Serial.println("Asset bundle mapping failed");
+        return false;
+    }
+    bundle = (const uint8_t *)ptr;
+    entries = (const asset_entry_t *)(bundle + sizeof(header));
+    entry_count = header.count;
+    bundle_size = header.size;
+    Serial.printf("Asset bundle: %d files, %uB\n", entry_count, header.size);
+    return true;
+}
+
+bool asset_find(const char *path, asset_t *asset){
+    // The index is sorted by path
+    int low = 0;
+    int high = entry_count - 1;
+    while (low <= high){
+        int mid = (low + high) / 2;
+        const asset_entry_t *entry = &entries[mid];
+        int cmp = strncmp(path, entry->path, ASSET_PATH_SIZE);
+        if (cmp < 0){
+            high = mid - 1;
+        } else if (cmp > 0){
+            low = mid + 1;
+        } else if (entry->offset + entry->size <= bundle_size){
+            asset->path = entry->path;
+            asset->data = bundle + entry->offset;
+            asset->size = entry->size;
+            asset->gzip = entry->flags & ASSET_FLAG_GZIP;
+            asset->etag = entry->etag;
+            return true;
+        } else {
+            return false; // Corrupt entry
+        }
+    }
+    return false;
+}
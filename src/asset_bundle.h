@@ -0,0 +1,25 @@
+#ifndef ASSET_BUNDLE_H
+#define ASSET_BUNDLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Read-only bundle of the data/ files in the "assets" flash partition
+// (scripts/pack_assets.py, pio run -t uploadassets). The partition is memory
+// mapped once, assets are sent straight from flash.
+
+typedef struct {
+    const char *path;
+    const uint8_t *data; // Mapped flash
+    size_t size;
+    bool gzip;           // Stored gzipped, send with Content-Encoding: gzip
+    uint32_t etag;       // FNV-1a of the stored bytes
+} asset_t;
+
+// Map the partition, false if there is none or it holds no valid bundle
+bool asset_bundle_init();
+
+// Look an asset up by path ("/logo.png"), false if it is not in the bundle
+bool asset_find(const char *path, asset_t *asset);
+
+#endif // ASSET_BUNDLE_H
@@ -0,0 +1,115 @@
+/*
+  ESP32CAM rcCar
+  Burst capture into a PSRAM arena, for /burst
+*/
+
+#include "burst_recorder.h"
+#include "frame_broadcaster.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "Arduino.h"
+#include <user_define.h>
+
+static uint8_t *burst_buf = NULL;
+static size_t burst_size = 0;
+static burst_frame_t burst_frames[BURST_MAX_FRAMES];
+static int burst_count = 0;
+
+bool burst_recorder_init(size_t reserve){
+    if (burst_buf){
+        return true;
+    }
+    // Settle for a shorter burst if PSRAM is short, leaving reserve for the frame pool
+    for (burst_size = BURST_BUFFER_SIZE; burst_size >= 256 * 1024; burst_size /= 2){
+        if (heap_caps_get_free_size(MALLOC_CAP_SPIRAM) < burst_size + reserve){
+            continue;
+        }
+        burst_buf = (uint8_t *)heap_caps_malloc(burst_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (burst_buf){
+            break;
+        }
+    }
+    if (!burst_buf){
+        Serial.println("Burst buffer allocation failed");
+        return false;
+    }
+    Serial.printf("Burst buffer: %uB\n", (uint32_t)burst_size);
+    return true;
+}
+
+// Append a frame to the arena, false once it is full
+static bool burst_append(const uint8_t *jpg, size_t len, int64_t timestamp, uint32_t seq, size_t *used){
+    if (burst_count == BURST_MAX_FRAMES || *used + len > burst_size){
+        return false;
+    }
+    memcpy(burst_buf + *used, jpg, len);
+    burst_frame_t *frame = &burst_frames[burst_count++];
+    frame->buf = burst_buf + *used;
+    frame->len = len;
+    frame->timestamp = timestamp;
+    frame->seq = seq;
+    *used += len;
+    return true;
+}
+
+int burst_capture(int n, int interval_ms){
+    burst_count = 0;
+    if (!burst_buf || n <= 0){
+        return 0;
+    }
+    n = min(n, BURST_MAX_FRAMES);
+    // The server task is busy until the burst is sent, bound the capture time
+    if (interval_ms > 0){
+        n = max(1, min(n, BURST_MAX_DURATION_MS / interval_ms));
+    }
+
+    // Taking frames from the capture task keeps the stream running, subscribing
+    // starts the capture task if nobody is watching. A grab slot is not one of the
+    // MAX_STREAM_CLIENTS viewers' slots, and is told about held back frames too.
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    bool subscribed = broadcaster_subscribe_grab(self);
+
+    size_t used = 0;
+    uint32_t last_seq = 0;
+    int64_t last_timestamp = 0;
+    int64_t start = esp_timer_get_time();
+    int64_t deadline = start + (int64_t)n * max(interval_ms, 100) * 1000 + 2000000;
+    while (burst_count < n && esp_timer_get_time() < deadline){
+        // Frames held back by the scene detector count too, take the latest one
+        shared_frame_t *frame = broadcaster_acquire_latest(INT64_MAX);
+        if (!frame || frame->seq == last_seq){
+            broadcaster_release(frame);
+            // Woken by the next frame, the timeout only rechecks the deadline
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(subscribed ? 100 : 2));
+            continue;
+        }
+        last_seq = frame->seq;
+        bool keep = !burst_count || frame->timestamp - last_timestamp >= interval_ms * 1000LL;
+        bool appended = !keep || burst_append(frame->buf, frame->len, frame->timestamp, frame->seq, &used);
+        if (keep){
+            last_timestamp = frame->timestamp;
+        }
+        broadcaster_release(frame);
+        if (!appended){
+            break; // Arena full
+        }
+    }
+
+    if (subscribed){
+        broadcaster_unsubscribe(self);
+    }
+    ulTaskNotifyTake(pdTRUE, 0); // Don't leave a stale notification on the server task
+
+    int64_t span = burst_count > 1 ? burst_frames[burst_count - 1].timestamp - burst_frames[0].timestamp : 0;
+    Serial.printf("Burst: %d frames, %uB, %ums span, %ums total\n", burst_count, (uint32_t)used,
+                  (uint32_t)(span / 1000), (uint32_t)((esp_timer_get_time() - start) / 1000));
+    return burst_count;
+}
+
+bool burst_frame(int i, burst_frame_t *frame){
+    if (i < 0 || i >= burst_count){
+        return false;
+    }
+    *frame = burst_frames[i];
+    return true;
+}
@@ -0,0 +1,28 @@
+#ifndef BURST_RECORDER_H
+#define BURST_RECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Back-to-back frames captured into a preallocated PSRAM arena, nothing is sent
+// until the burst is over
+
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    int64_t timestamp; // esp_timer_get_time() at VSYNC
+    uint32_t seq;      // Capture sequence number, gaps are frames skipped by interval_ms
+} burst_frame_t;
+
+// Allocate the arena leaving reserve bytes of PSRAM free, false if PSRAM is short
+bool burst_recorder_init(size_t reserve);
+
+// Capture up to n frames at least interval_ms apart, as fast as the sensor allows with 0.
+// Stops early when the arena is full, n is cut to BURST_MAX_DURATION_MS / interval_ms.
+// Returns the number of frames captured.
+int burst_capture(int n, int interval_ms);
+
+// Frame i of the last burst, valid until the next burst_capture()
+bool burst_frame(int i, burst_frame_t *frame);
+
+#endif // BURST_RECORDER_H
@@ -0,0 +1,283 @@
+/*
+  ESP32CAM rcCar
+  Pre-event clip recorder, downloaded as an MJPEG AVI
+*/
+
+#include "clip_recorder.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "Arduino.h"
+#include <user_define.h>
+
+typedef struct {
+    uint32_t offset;   // Position in the ring buffer
+    uint32_t len;
+    int64_t timestamp;
+} clip_frame_t;
+
+static SemaphoreHandle_t clip_mutex = NULL;
+static uint8_t *clip_buf = NULL;
+static size_t clip_size = 0;
+static clip_frame_t *clip_index = NULL;
+static int clip_head = 0;        // Oldest frame
+static int clip_count = 0;
+static uint32_t clip_wpos = 0;   // Next write position
+static uint16_t clip_width = 0;
+static uint16_t clip_height = 0;
+static bool clip_frozen = false; // Set while a clip is being downloaded
+
+bool clip_recorder_init(size_t reserve){
+    if (clip_buf){
+        return true;
+    }
+    clip_index = (clip_frame_t *)heap_caps_malloc(CLIP_MAX_FRAMES * sizeof(clip_frame_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    // Settle for a shorter clip if PSRAM is short, leaving reserve for the frame pool
+    for (clip_size = CLIP_BUFFER_SIZE; clip_index && clip_size >= 256 * 1024; clip_size /= 2){
+        if (heap_caps_get_free_size(MALLOC_CAP_SPIRAM) < clip_size + reserve){
+            continue;
+        }
+        clip_buf = (uint8_t *)heap_caps_malloc(clip_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (clip_buf){
+            break;
+        }
+    }
+    if (!clip_buf){
+        Serial.println("Clip buffer allocation failed");
+        free(clip_index);
+        clip_index = NULL;
+        return false;
+    }
+    clip_mutex = xSemaphoreCreateMutex();
+    Serial.printf("Clip buffer: %uB\n", (uint32_t)clip_size);
+    return true;
+}
+
+static void clip_drop_oldest(){
+    clip_head = (clip_head + 1) % CLIP_MAX_FRAMES;
+    clip_count--;
+}
+
+void clip_record(const uint8_t *jpg, size_t len, int64_t timestamp, size_t width, size_t height){
+    if (!clip_buf || !len || len > clip_size){
+        return;
+    }
+    if (xSemaphoreTake(clip_mutex, 0) != pdTRUE){
+        return;
+    }
+    if (clip_frozen){
+        xSemaphoreGive(clip_mutex);
+        return;
+    }
+
+    // Frames are stored contiguously, wrap to the start when the tail is too short.
+    // Everything between the write position and the end is then the oldest data.
+    if (clip_wpos + len > clip_size){
+        while (clip_count && clip_index[clip_head].offset >= clip_wpos){
+            clip_drop_oldest();
+        }
+        clip_wpos = 0;
+    }
+    // Drop the frames the new one overwrites
+    while (clip_count && clip_index[clip_head].offset >= clip_wpos && clip_index[clip_head].offset < clip_wpos + len){
+        clip_drop_oldest();
+    }
+    // Only keep CLIP_SECONDS
+    while (clip_count && timestamp - clip_index[clip_head].timestamp > CLIP_SECONDS * 1000000LL){
+        clip_drop_oldest();
+    }
+    if (clip_count == CLIP_MAX_FRAMES){
+        clip_drop_oldest();
+    }
+
+    memcpy(clip_buf + clip_wpos, jpg, len);
+    clip_frame_t *frame = &clip_index[(clip_head + clip_count) % CLIP_MAX_FRAMES];
+    frame->offset = clip_wpos;
+    frame->len = len;
+    frame->timestamp = timestamp;
+    clip_count++;
+    clip_wpos += len;
+    clip_width = width;
+    clip_height = height;
+
+    xSemaphoreGive(clip_mutex);
+}
+
+// AVI (RIFF) helpers, little endian
+static uint8_t *avi_u32(uint8_t *p, uint32_t v){
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+    return p + 4;
+}
+
+static uint8_t *avi_u16(uint8_t *p, uint16_t v){
+    p[0] = v;
+    p[1] = v >> 8;
+    return p + 2;
+}
+
+static uint8_t *avi_fourcc(uint8_t *p, const char *fourcc){
+    memcpy(p, fourcc, 4);
+    return p + 4;
+}
+
+#define AVI_HDRL_SIZE 192 // 'hdrl' + avih + LIST strl (strh + strf)
+
+// RIFF, hdrl and the start of the movi list
+static size_t avi_header(uint8_t *buf, int frames, uint32_t movi_size, uint32_t max_len, uint32_t us_per_frame){
+    uint8_t *p = buf;
+    uint32_t idx1_size = 16 * frames;
+
+    p = avi_fourcc(p, "RIFF");
+    p = avi_u32(p, 4 + (8 + AVI_HDRL_SIZE) + (8 + movi_size) + (8 + idx1_size));
+    p = avi_fourcc(p, "AVI ");
+
+    p = avi_fourcc(p, "LIST");
+    p = avi_u32(p, AVI_HDRL_SIZE);
+    p = avi_fourcc(p, "hdrl");
+
+    // Main header
+    p = avi_fourcc(p, "avih");
+    p = avi_u32(p, 56);
+    p = avi_u32(p, us_per_frame);
+    p = avi_u32(p, (uint64_t)max_len * 1000000 / us_per_frame); // Max bytes per second
+    p = avi_u32(p, 0);           // Padding granularity
+    p = avi_u32(p, 0x10);        // AVIF_HASINDEX
+    p = avi_u32(p, frames);
+    p = avi_u32(p, 0);           // Initial frames
+    p = avi_u32(p, 1);           // Streams
+    p = avi_u32(p, max_len);     // Suggested buffer size
+    p = avi_u32(p, clip_width);
+    p = avi_u32(p, clip_height);
+    memset(p, 0, 16);            // Reserved
+    p += 16;
+
+    p = avi_fourcc(p, "LIST");
+    p = avi_u32(p, 4 + (8 + 56) + (8 + 40));
+    p = avi_fourcc(p, "strl");
+
+    // Video stream header
+    p = avi_fourcc(p, "strh");
+    p = avi_u32(p, 56);
+    p = avi_fourcc(p, "vids");
+    p = avi_fourcc(p, "MJPG");
+    p = avi_u32(p, 0);           // Flags
+    p = avi_u16(p, 0);           // Priority
+    p = avi_u16(p, 0);           // Language
+    p = avi_u32(p, 0);           // Initial frames
+    p = avi_u32(p, us_per_frame); // Scale
+    p = avi_u32(p, 1000000);     // Rate, rate / scale = fps
+    p = avi_u32(p, 0);           // Start
+    p = avi_u32(p, frames);      // Length
+    p = avi_u32(p, max_len);     // Suggested buffer size
+    p = avi_u32(p, 0xFFFFFFFF);  // Quality
+    p = avi_u32(p, 0);           // Sample size
+    p = avi_u16(p, 0);           // Frame rectangle
+    p = avi_u16(p, 0);
+    p = avi_u16(p, clip_width);
+    p = avi_u16(p, clip_height);
+
+    // Video format (BITMAPINFOHEADER)
+    p = avi_fourcc(p, "strf");
+    p = avi_u32(p, 40);
+    p = avi_u32(p, 40);
+    p = avi_u32(p, clip_width);
+    p = avi_u32(p, clip_height);
+    p = avi_u16(p, 1);           // Planes
+    p = avi_u16(p, 24);          // Bit count
+    p = avi_fourcc(p, "MJPG");
+    p = avi_u32(p, clip_width * clip_height * 3);
+    memset(p, 0, 16);            // Resolution and palette
+    p += 16;
+
+    p = avi_fourcc(p, "LIST");
+    p = avi_u32(p, movi_size);
+    p = avi_fourcc(p, "movi");
+    return p - buf;
+}
+
+esp_err_t clip_send_avi(httpd_req_t *req){
+    if (!clip_buf){
+        httpd_resp_send_404(req);
+        return ESP_FAIL;
+    }
+
+    // Freeze the ring, the capture task skips recording until the download is done.
+    // An empty ring is left recording, there is nothing to send.
+    xSemaphoreTake(clip_mutex, portMAX_DELAY);
+    int head = clip_head;
+    int count = clip_count;
+    clip_frozen = count > 0;
+    xSemaphoreGive(clip_mutex);
+
+    if (!count){
+        httpd_resp_send_404(req);
+        return ESP_FAIL;
+    }
+
+    uint32_t movi_size = 4;
+    uint32_t max_len = 0;
+    for (int i = 0; i < count; i++){
+        clip_frame_t *frame = &clip_index[(head + i) % CLIP_MAX_FRAMES];
+        movi_size += 8 + ((frame->len + 1) & ~1);
+        max_len = max(max_len, frame->len);
+    }
+    int64_t duration = clip_index[(head + count - 1) % CLIP_MAX_FRAMES].timestamp - clip_index[head].timestamp;
+    uint32_t us_per_frame = count > 1 ? duration / (count - 1) : 100000;
+    if (!us_per_frame){
+        us_per_frame = 100000;
+    }
+
+    httpd_resp_set_type(req, "video/x-msvideo");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=clip.avi");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+
+    uint8_t buf[16 * 32]; // Headers and 32 index entries at a time
+    size_t len = avi_header(buf, count, movi_size, max_len, us_per_frame);
+    esp_err_t res = httpd_resp_send_chunk(req, (const char *)buf, len);
+
+    // movi: frames are sent straight from the ring buffer
+    for (int i = 0; i < count && res == ESP_OK; i++){
+        clip_frame_t *frame = &clip_index[(head + i) % CLIP_MAX_FRAMES];
+        uint8_t *p = avi_fourcc(buf, "00dc");
+        p = avi_u32(p, frame->len);
+        res = httpd_resp_send_chunk(req, (const char *)buf, p - buf);
+        if (res == ESP_OK){
+            res = httpd_resp_send_chunk(req, (const char *)clip_buf + frame->offset, frame->len);
+        }
+        if (res == ESP_OK && (frame->len & 1)){
+            res = httpd_resp_send_chunk(req, "\0", 1); // Chunks are word aligned
+        }
+    }
+
+    // idx1: offsets are relative to the 'movi' fourcc
+    if (res == ESP_OK){
+        uint8_t *p = avi_fourcc(buf, "idx1");
+        p = avi_u32(p, 16 * count);
+        res = httpd_resp_send_chunk(req, (const char *)buf, p - buf);
+    }
+    uint32_t offset = 4;
+    for (int i = 0; i < count && res == ESP_OK; i += 32){
+        uint8_t *p = buf;
+        for (int j = i; j < count && j < i + 32; j++){
+            clip_frame_t *frame = &clip_index[(head + j) % CLIP_MAX_FRAMES];
+            p = avi_fourcc(p, "00dc");
+            p = avi_u32(p, 0x10); // AVIIF_KEYFRAME
+            p = avi_u32(p, offset);
+            p = avi_u32(p, frame->len);
+            offset += 8 + ((frame->len + 1) & ~1);
+        }
+        res = httpd_resp_send_chunk(req, (const char *)buf, p - buf);
+    }
+    if (res == ESP_OK){
+        res = httpd_resp_send_chunk(req, NULL, 0);
+    }
+
+    xSemaphoreTake(clip_mutex, portMAX_DELAY);
+    clip_frozen = false;
+    xSemaphoreGive(clip_mutex);
+    Serial.printf("Clip: %d frames, %ums\n", count, (uint32_t)(duration / 1000));
+    return res;
+}
@@ -0,0 +1,20 @@
+#ifndef CLIP_RECORDER_H
+#define CLIP_RECORDER_H
+
+#include "esp_http_server.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Ring buffer in PSRAM holding the last CLIP_SECONDS of frames
+
+// Allocate the ring buffer leaving reserve bytes of PSRAM free, false if PSRAM is short
+bool clip_recorder_init(size_t reserve);
+
+// Append a JPEG frame, the oldest frames are dropped to make room.
+// Frames are skipped while a clip is being downloaded.
+void clip_record(const uint8_t *jpg, size_t len, int64_t timestamp, size_t width, size_t height);
+
+// Send the buffered frames as an MJPEG AVI built on the fly from the ring
+esp_err_t clip_send_avi(httpd_req_t *req);
+
+#endif // CLIP_RECORDER_H
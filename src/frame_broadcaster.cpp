@@ -0,0 +1,530 @@
+/*
+  ESP32CAM rcCar
+  Single capture task feeding every stream client
+*/
+
+#include "frame_broadcaster.h"
+#include "esp_timer.h"
+#include "img_converters.h"
+#include "esp_heap_caps.h"
+#include "freertos/semphr.h"
+#include "Arduino.h"
+#include <user_define.h>
+#include <scene_detector.h>
+#include <jpeg_dc.h>
+#include "clip_recorder.h"
+
+// One record per client, one for the latest frame, one being captured, and one
+// each for /capture (held while it is sent) and /burst (held while it is copied)
+#define FRAME_RECORDS (MAX_STREAM_CLIENTS + 4)
+// Without PSRAM the records come out of internal RAM: the latest frame, the one
+// being captured and one sender, the other clients skip more frames
+#define FRAME_RECORDS_DRAM 3
+
+extern volatile float camera_fps;
+
+static portMUX_TYPE frame_mux = portMUX_INITIALIZER_UNLOCKED;
+static shared_frame_t frames[FRAME_RECORDS];
+static int frame_slots = 0;      // Records in use, FRAME_RECORDS or FRAME_RECORDS_DRAM
+static size_t max_slot_size = 0; // Slot for the largest framesize, records grow up to it
+static uint32_t slot_caps = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+static shared_frame_t *latest_frame = NULL;
+static uint32_t frame_seq = 0;
+static uint32_t stream_seq = 0;
+
+// Stream clients, then up to GRAB_SUBSCRIBERS handlers waiting for a single frame
+#define GRAB_SUBSCRIBERS 2 // One per HTTP server task, for /capture and /burst
+#define SUBSCRIBERS (MAX_STREAM_CLIENTS + GRAB_SUBSCRIBERS)
+
+static TaskHandle_t subscribers[SUBSCRIBERS];
+static bool subscriber_grab[SUBSCRIBERS]; // Told about held back frames as well
+static int subscriber_count = 0;
+static int grab_count = 0;
+static TaskHandle_t capture_task = NULL;
+static framesize_t max_frame_size = FRAMESIZE_QVGA;
+
+// Photo mode
+static SemaphoreHandle_t camera_mutex = NULL;
+static volatile bool capture_paused = false;
+
+static volatile int raw_quality = RAW_JPEG_QUALITY;
+
+// Idle scene suppression
+static const scene_config_t scene_config = {
+    .size_threshold = 0.02f,
+    .signature_threshold = 4,
+    .idle_after_ms = 2000,
+    .keepalive_ms = SCENE_KEEPALIVE_MS,
+};
+static scene_state_t scene_state;
+static jpeg_dc_decoder_t scene_decoder;
+static uint8_t scene_thumbnail[SCENE_SIGNATURE_MAX]; // Frames up to QVGA, larger ones are compared by size only
+static volatile bool scene_rearm_pending = false;
+
+static shared_frame_t *frame_alloc(){
+    shared_frame_t *frame = NULL;
+    portENTER_CRITICAL(&frame_mux);
+    for (int i = 0; i < frame_slots; i++){
+        if (!frames[i].busy){
+            frame = &frames[i];
+            frame->busy = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&frame_mux);
+    return frame;
+}
+
+// Size the record's buffer for the framesize being captured, the driver's own
+// bound for a JPEG of that size. Only the capture task calls it, on a record
+// nobody else holds yet.
+static bool frame_fit(shared_frame_t *frame, camera_fb_t *fb){
+    size_t size = min(max_slot_size, (size_t)(fb->width * fb->height / 5));
+    if (frame->buf && frame->size >= size){
+        return true;
+    }
+    free(frame->buf);
+    frame->buf = (uint8_t *)heap_caps_malloc(size, slot_caps);
+    frame->size = frame->buf ? size : 0;
+    if (!frame->buf){
+        Serial.printf("Frame pool: no room for a %ux%u slot\n", fb->width, fb->height);
+    }
+    return frame->buf != NULL;
+}
+
+static void frame_free(shared_frame_t *frame){
+    frame->len = 0;
+    portENTER_CRITICAL(&frame_mux);
+    frame->busy = false;
+    portEXIT_CRITICAL(&frame_mux);
+}
+
+// Make the frame the latest one, stream clients are only told about streamed frames
+static void frame_publish(shared_frame_t *frame, bool streamed){
+    TaskHandle_t notify[SUBSCRIBERS];
+    int count = 0;
+
+    portENTER_CRITICAL(&frame_mux);
+    frame->seq = ++frame_seq;
+    frame->refs = 1; // Reference held as the latest frame
+    frame->streamed = streamed;
+    frame->stream_seq = streamed ? ++stream_seq : stream_seq;
+    shared_frame_t *previous = latest_frame;
+    latest_frame = frame;
+    for (int i = 0; i < subscriber_count; i++){
+        if (streamed || subscriber_grab[i]){
+            notify[count++] = subscribers[i];
+        }
+    }
+    portEXIT_CRITICAL(&frame_mux);
+
+    broadcaster_release(previous);
+    for (int i = 0; i < count; i++){
+        xTaskNotifyGive(notify[i]);
+    }
+}
+
+// Raw formats: the encoder writes straight into the pool slot, the JPEG is not
+// copied out of a heap buffer. frame2jpg_cb still news up its encoder for every
+// frame, the class is private to esp32-camera and can't be kept between frames.
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t len;
+} slot_writer_t;
+
+static size_t slot_write(void *arg, size_t index, const void *data, size_t len){
+    slot_writer_t *writer = (slot_writer_t *)arg;
+    if (index + len > writer->size){
+        return 0; // Stops the encoder
+    }
+    memcpy(writer->buf + index, data, len);
+    writer->len = index + len;
+    return len;
+}
+
+// Subsampled copy of the last encoded frame: the first byte of every
+// RAW_SAMPLE_STEP-th pixel of every RAW_SAMPLE_STEP-th row. Luma in YUV422, the
+// high byte (red and some green) in RGB565.
+static uint8_t *raw_reference = NULL;
+static size_t raw_reference_size = 0;
+static bool raw_reference_valid = false;
+
+// Compare the frame with the reference in tiles of RAW_TILE pixels square. One tile
+// whose mean absolute difference is over RAW_CHANGE_THRESHOLD is a change, so a
+// small object or sideways motion counts as much as a change across the frame.
+static bool raw_changed(camera_fb_t *fb, uint8_t *samples){
+    const int step = RAW_SAMPLE_STEP;
+    const int tile = RAW_TILE / RAW_SAMPLE_STEP; // Samples per tile side
+    size_t bpp = fb->len / (fb->width * fb->height);
+    int cols = fb->width / step;
+    int rows = fb->height / step;
+    for (int y = 0; y < rows; y++){
+        const uint8_t *row = fb->buf + (size_t)y * step * fb->width * bpp;
+        for (int x = 0; x < cols; x++){
+            samples[y * cols + x] = row[(size_t)x * step * bpp];
+        }
+    }
+    if (!raw_reference_valid){
+        return true;
+    }
+    for (int ty = 0; ty < rows; ty += tile){
+        for (int tx = 0; tx < cols; tx += tile){
+            uint32_t sad = 0;
+            int count = 0;
+            for (int y = ty; y < min(rows, ty + tile); y++){
+                for (int x = tx; x < min(cols, tx + tile); x++){
+                    int i = y * cols + x;
+                    sad += abs(samples[i] - raw_reference[i]);
+                    count++;
+                }
+            }
+            if (sad > (uint32_t)count * RAW_CHANGE_THRESHOLD){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Reuse the previous JPEG when nothing changed, a still scene costs a copy instead
+// of an encode. The copy keeps the timestamp of the frame it was encoded from.
+static bool raw_reuse(camera_fb_t *fb, shared_frame_t *frame){
+    shared_frame_t *previous = broadcaster_acquire_latest(INT64_MAX);
+    bool reused = previous && previous->width == fb->width && previous->height == fb->height;
+    if (reused){
+        memcpy(frame->buf, previous->buf, previous->len);
+        frame->len = previous->len;
+        frame->timestamp = previous->timestamp;
+    }
+    broadcaster_release(previous);
+    return reused;
+}
+
+static bool raw_encode(camera_fb_t *fb, shared_frame_t *frame){
+    bool track = false;
+    size_t samples_size = (fb->width / RAW_SAMPLE_STEP) * (fb->height / RAW_SAMPLE_STEP);
+    if (RAW_SKIP_UNCHANGED){
+        if (samples_size != raw_reference_size){
+            // Two buffers, the samples of this frame and the reference
+            free(raw_reference);
+            raw_reference = (uint8_t *)heap_caps_malloc(samples_size * 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            raw_reference_size = raw_reference ? samples_size : 0;
+            raw_reference_valid = false;
+        }
+        track = raw_reference != NULL;
+    }
+    uint8_t *samples = track ? raw_reference + samples_size : NULL;
+    if (track && !raw_changed(fb, samples) && raw_reuse(fb, frame)){
+        return true;
+    }
+
+    slot_writer_t writer = {frame->buf, frame->size, 0};
+    if (!frame2jpg_cb(fb, raw_quality, slot_write, &writer)){
+        Serial.println("JPEG compression failed");
+        return false;
+    }
+    frame->len = writer.len;
+    if (track){
+        memcpy(raw_reference, samples, samples_size);
+        raw_reference_valid = true;
+    }
+    return true;
+}
+
+// Copy the frame out and give the buffer straight back to the driver,
+// a slow client then only delays its own copy, never the sensor
+static bool frame_capture(shared_frame_t *frame){
+    camera_fb_t *fb = esp_camera_fb_get();
+    if (!fb){
+        Serial.println("Camera capture failed");
+        return false;
+    }
+    // Stamped by the driver at VSYNC, when the sensor started the frame
+    frame->timestamp = (int64_t)fb->timestamp.tv_sec * 1000000 + fb->timestamp.tv_usec;
+    frame->checked = frame->timestamp;
+    frame->width = fb->width;
+    frame->height = fb->height;
+
+    bool captured = frame_fit(frame, fb); // Logs when there is no room
+    if (captured && fb->format != PIXFORMAT_JPEG){
+        captured = raw_encode(fb, frame);
+    }
+    else if (captured && fb->len <= frame->size){
+        memcpy(frame->buf, fb->buf, fb->len);
+        frame->len = fb->len;
+    }
+    else if (captured){
+        Serial.printf("Frame too large for the pool: %uB\n", (uint32_t)fb->len);
+        captured = false;
+    }
+    esp_camera_fb_return(fb);
+    return captured;
+}
+
+static void capture_task_fn(void *arg){
+    int64_t last_fps_time = esp_timer_get_time();
+    int frame_count = 0;
+
+    while (true){
+        // Sleep until a client subscribes
+        portENTER_CRITICAL(&frame_mux);
+        int count = subscriber_count;
+        portEXIT_CRITICAL(&frame_mux);
+        if (!count){
+            // Give the last frame back to the driver while nobody is watching
+            portENTER_CRITICAL(&frame_mux);
+            shared_frame_t *previous = latest_frame;
+            latest_frame = NULL;
+            portEXIT_CRITICAL(&frame_mux);
+            broadcaster_release(previous);
+
+            camera_fps = 0;
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            last_fps_time = esp_timer_get_time();
+            frame_count = 0;
+            continue;
+        }
+        if (capture_paused){
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+
+        shared_frame_t *frame = frame_alloc();
+        if (!frame){
+            vTaskDelay(1);
+            continue;
+        }
+
+        // Photo mode owns the sensor while it is paused
+        xSemaphoreTake(camera_mutex, portMAX_DELAY);
+        bool captured = frame_capture(frame);
+        xSemaphoreGive(camera_mutex);
+        if (!captured){
+            frame_free(frame);
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+
+        clip_record(frame->buf, frame->len, frame->checked, frame->width, frame->height);
+
+        // FPS calculation
+        frame_count++;
+        int64_t now = esp_timer_get_time();
+        if (now - last_fps_time > 1000000) { // 1 second
+            camera_fps = frame_count * 1000000.0f / (now - last_fps_time);
+            frame_count = 0;
+            last_fps_time = now;
+        }
+
+        bool send = true;
+        if (SCENE_SUPPRESS){
+            int64_t now_ms = now / 1000;
+            bool was_idle = scene_state.idle;
+            if (scene_rearm_pending){
+                scene_rearm_pending = false;
+                scene_rearm(&scene_state, now_ms);
+            }
+            // 1/8 luma thumbnail from the DC coefficients, no full decode
+            int thumb_w, thumb_h;
+            bool thumb = jpeg_dc_thumbnail(&scene_decoder, frame->buf, frame->len, scene_thumbnail,
+                                           sizeof(scene_thumbnail), &thumb_w, &thumb_h);
+            send = scene_update(&scene_config, &scene_state, frame->len, thumb ? scene_thumbnail : NULL,
+                                thumb ? thumb_w * thumb_h : 0, now_ms);
+            if (scene_state.idle != was_idle){
+                Serial.println(scene_state.idle ? "Scene idle, throttling stream" : "Scene active");
+            }
+        }
+        // Frames held back still become the latest one, for /capture
+        frame_publish(frame, send);
+    }
+}
+
+void broadcaster_start(framesize_t max_framesize){
+    if (capture_task){
+        return;
+    }
+
+    max_frame_size = max_framesize;
+    camera_mutex = xSemaphoreCreateMutex();
+
+    // Slots are sized for the framesize streamed now and grow when a larger one is
+    // picked, up to the bound the camera driver uses for its JPEG buffers.
+    // Photos are taken from the driver's buffers, never from the pool.
+    max_slot_size = resolution[max_framesize].width * resolution[max_framesize].height / 5;
+    sensor_t *s = esp_camera_sensor_get();
+    framesize_t framesize = s ? (framesize_t)s->status.framesize : max_framesize;
+    size_t size = min(max_slot_size, (size_t)(resolution[framesize].width * resolution[framesize].height / 5));
+    int records = FRAME_RECORDS;
+    if (!psramFound()){
+        slot_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+        records = FRAME_RECORDS_DRAM;
+    }
+    for (frame_slots = 0; frame_slots < records; frame_slots++){
+        uint8_t *buf = (uint8_t *)heap_caps_malloc(size, slot_caps);
+        if (!buf){
+            break; // Fewer slots only means slow clients skip more frames
+        }
+        frames[frame_slots].buf = buf;
+        frames[frame_slots].size = size;
+    }
+    Serial.printf("Frame pool: %d slots of %uB in %s, up to %uB each\n", frame_slots, (uint32_t)size,
+                  psramFound() ? "PSRAM" : "internal RAM", (uint32_t)max_slot_size);
+    scene_reset(&scene_state, esp_timer_get_time() / 1000);
+    if (frame_slots < 2){
+        Serial.println("Frame pool allocation failed");
+        return;
+    }
+    BaseType_t core = CAMERA_LOW_LATENCY ? CAMERA_TASK_CORE : tskNO_AFFINITY;
+    xTaskCreatePinnedToCore(capture_task_fn, "capture", 4096, NULL, 5, &capture_task, core);
+}
+
+static bool subscribe(TaskHandle_t task, bool grab){
+    bool added = false;
+    portENTER_CRITICAL(&frame_mux);
+    int limit = grab ? GRAB_SUBSCRIBERS : MAX_STREAM_CLIENTS;
+    int used = grab ? grab_count : subscriber_count - grab_count;
+    if (used < limit){
+        subscriber_grab[subscriber_count] = grab;
+        subscribers[subscriber_count++] = task;
+        grab_count += grab;
+        added = true;
+    }
+    portEXIT_CRITICAL(&frame_mux);
+
+    if (added && capture_task){
+        xTaskNotifyGive(capture_task); // Wake the capture task up
+    }
+    return added;
+}
+
+bool broadcaster_subscribe(TaskHandle_t task){
+    return subscribe(task, false);
+}
+
+bool broadcaster_subscribe_grab(TaskHandle_t task){
+    return subscribe(task, true);
+}
+
+void broadcaster_unsubscribe(TaskHandle_t task){
+    portENTER_CRITICAL(&frame_mux);
+    for (int i = 0; i < subscriber_count; i++){
+        if (subscribers[i] == task){
+            grab_count -= subscriber_grab[i];
+            subscriber_count--;
+            subscribers[i] = subscribers[subscriber_count];
+            subscriber_grab[i] = subscriber_grab[subscriber_count];
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&frame_mux);
+}
+
+shared_frame_t *broadcaster_acquire(uint32_t last_seq){
+    shared_frame_t *frame = NULL;
+    portENTER_CRITICAL(&frame_mux);
+    if (latest_frame && latest_frame->streamed && latest_frame->seq != last_seq){
+        frame = latest_frame;
+        frame->refs++;
+    }
+    portEXIT_CRITICAL(&frame_mux);
+    return frame;
+}
+
+shared_frame_t *broadcaster_acquire_latest(int64_t max_age_us){
+    shared_frame_t *frame = NULL;
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&frame_mux);
+    if (latest_frame && now - latest_frame->checked <= max_age_us){
+        frame = latest_frame;
+        frame->refs++;
+    }
+    portEXIT_CRITICAL(&frame_mux);
+    return frame;
+}
+
+shared_frame_t *broadcaster_grab(int64_t max_age_us, TickType_t timeout){
+    shared_frame_t *frame = broadcaster_acquire_latest(max_age_us);
+    if (frame || !capture_task){
+        return frame;
+    }
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    if (!broadcaster_subscribe_grab(self)){
+        return NULL;
+    }
+    TickType_t start = xTaskGetTickCount();
+    TickType_t waited = 0;
+    while (!frame && waited < timeout){
+        ulTaskNotifyTake(pdTRUE, timeout - waited);
+        frame = broadcaster_acquire_latest(max_age_us);
+        waited = xTaskGetTickCount() - start;
+    }
+    broadcaster_unsubscribe(self);
+    ulTaskNotifyTake(pdTRUE, 0); // A frame published while leaving
+    return frame;
+}
+
+bool broadcaster_running(){
+    return capture_task != NULL;
+}
+
+void broadcaster_rearm(){
+    scene_rearm_pending = true;
+}
+
+bool broadcaster_pause(TickType_t timeout){
+    if (!camera_mutex){
+        return true; // No capture task to stop
+    }
+    capture_paused = true;
+    if (xSemaphoreTake(camera_mutex, timeout) != pdTRUE){
+        capture_paused = false;
+        return false;
+    }
+    return true;
+}
+
+void broadcaster_resume(){
+    if (!camera_mutex){
+        return;
+    }
+    xSemaphoreGive(camera_mutex);
+    capture_paused = false;
+}
+
+void broadcaster_set_raw_quality(int quality){
+    raw_quality = constrain(quality, 1, 100);
+    raw_reference_valid = false; // Encode the next frame at the new quality
+}
+
+int broadcaster_raw_quality(){
+    return raw_quality;
+}
+
+framesize_t broadcaster_max_framesize(){
+    return max_frame_size;
+}
+
+size_t broadcaster_pool_growth(){
+    if (!psramFound()){
+        return 0; // Internal RAM, the PSRAM buffers don't compete with it
+    }
+    size_t growth = 0;
+    for (int i = 0; i < frame_slots; i++){
+        growth += max_slot_size - frames[i].size;
+    }
+    return growth;
+}
+
+void broadcaster_release(shared_frame_t *frame){
+    if (!frame){
+        return;
+    }
+    portENTER_CRITICAL(&frame_mux);
+    bool last = (--frame->refs == 0);
+    portEXIT_CRITICAL(&frame_mux);
+
+    if (last){
+        frame_free(frame);
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef FRAME_BROADCASTER_H
+#define FRAME_BROADCASTER_H
+
+#include "esp_camera.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// A captured frame shared by every stream client.
+// Frames are copied into a fixed set of slots (PSRAM when present) so the camera buffer goes
+// back to the driver right away, the slot is reused once the last reference is released.
+typedef struct {
+    uint8_t *buf;        // JPEG data, slot of size bytes in PSRAM (internal RAM without PSRAM)
+    size_t size;         // Slot size, grows with the framesize streamed
+    size_t len;          // JPEG length
+    size_t width;
+    size_t height;
+    int64_t timestamp;   // esp_timer_get_time() at VSYNC
+    int64_t checked;     // VSYNC of the last sensor frame it stands for, later than timestamp on a reused raw frame
+    uint32_t seq;        // Capture sequence number
+    uint32_t stream_seq; // Sequence number among streamed frames, gaps are frames a client missed
+    uint32_t refs;       // Number of holders (broadcaster + senders)
+    bool streamed;       // False for frames held back from the stream (idle scene)
+    bool busy;           // Record in use
+} shared_frame_t;
+
+// Allocate the frame pool for the sensor's current framesize, growing up to
+// max_framesize, and start the capture task. The camera is only read while someone is subscribed.
+void broadcaster_start(framesize_t max_framesize);
+
+// Register/unregister a task to be notified (xTaskNotifyGive) on every new frame
+bool broadcaster_subscribe(TaskHandle_t task);
+void broadcaster_unsubscribe(TaskHandle_t task);
+
+// Same for a handler after a few frames (/capture, /burst): notified on held back
+// frames as well, and not counted against MAX_STREAM_CLIENTS
+bool broadcaster_subscribe_grab(TaskHandle_t task);
+
+// Take a reference on the latest streamed frame if it is newer than last_seq, NULL otherwise
+shared_frame_t *broadcaster_acquire(uint32_t last_seq);
+
+// Take a reference on the latest captured frame if the sensor saw it at most max_age_us ago, NULL otherwise
+shared_frame_t *broadcaster_acquire_latest(int64_t max_age_us);
+
+// Latest frame of at most max_age_us, or the next one captured within timeout.
+// NULL if none came, the capture task is paused for a photo or was never started.
+shared_frame_t *broadcaster_grab(int64_t max_age_us, TickType_t timeout);
+
+// False when the frame pool could not be allocated, the camera is then free to read directly
+bool broadcaster_running();
+
+// Stop the capture task and take the sensor over, for a photo at another framesize.
+// False if the capture task did not let go within timeout.
+bool broadcaster_pause(TickType_t timeout);
+void broadcaster_resume();
+
+// JPEG quality (1-100) used to encode raw pixel formats
+void broadcaster_set_raw_quality(int quality);
+int broadcaster_raw_quality();
+
+// Largest framesize the camera buffers were allocated for
+framesize_t broadcaster_max_framesize();
+
+// PSRAM the frame pool takes on top of what it has now if max_framesize is streamed
+size_t broadcaster_pool_growth();
+
+// Drop a reference taken with broadcaster_acquire()
+void broadcaster_release(shared_frame_t *frame);
+
+// Motion was commanded, stream at full rate again without waiting for the scene to change
+void broadcaster_rearm();
+
+#endif // FRAME_BROADCASTER_H
@@ -0,0 +1,245 @@
+// Generated by scripts/embed_web.py from web/index.html, do not edit
+//File: index.html.gz, Size: 3837
+#define index_html_gz_len 3837
+const uint8_t index_html_gz[] = {
+ 0x1F, 0x8B, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0xFF, 0x69, 0x6E, 0x64, 0x65, 0x78, 0x2E,
+ 0x68, 0x74, 0x6D, 0x6C, 0x00, 0xC5, 0x5A, 0x79, 0x6F, 0xDB, 0x46, 0x16, 0xFF, 0xDF, 0x9F, 0x62,
+ 0xEA, 0x62, 0x43, 0x2A, 0x96, 0x28, 0xF9, 0x6A, 0x5D, 0xC9, 0x52, 0x90, 0xB3, 0x9B, 0x45, 0xB2,
+ 0x0D, 0x62, 0xB7, 0x4D, 0x37, 0x2D, 0x0A, 0x4A, 0x1C, 0x49, 0x93, 0xF0, 0x2A, 0x39, 0xB2, 0xAC,
+ 0x64, 0xFD, 0xDD, 0xF7, 0xF7, 0xDE, 0xCC, 0x50, 0x24, 0x25, 0xF7, 0x58, 0x2C, 0xB0, 0x36, 0x60,
+ 0x93, 0xC3, 0x37, 0xEF, 0x3E, 0x87, 0xBC, 0xFC, 0xA2, 0xD7, 0x13, 0xAF, 0xA5, 0x0E, 0x85, 0x0E,
+ 0x17, 0x22, 0x4C, 0x23, 0x71, 0xA3, 0xE4, 0x3A, 0xCF, 0x0A, 0x2D, 0x4A, 0xA9, 0xB5, 0x4A, 0x17,
+ 0xA5, 0xE8, 0xF5, 0x26, 0x07, 0x97, 0x09, 0xC1, 0xA4, 0x61, 0x22, 0xC7, 0x87, 0x0E, 0xE2, 0x50,
+ 0xCC, 0xB2, 0x54, 0xCB, 0x54, 0x8F, 0x0F, 0xD7, 0x2A, 0xD2, 0xCB, 0x71, 0x24, 0x6F, 0xD4, 0x4C,
+ 0xF6, 0xF8, 0xA6, 0x2B, 0x54, 0xAA, 0xB4, 0x0A, 0xE3, 0x5E, 0x39, 0x0B, 0x63, 0x39, 0x3E, 0x0E,
+ 0x06, 0x5D, 0x91, 0x84, 0xB7, 0x2A, 0x59, 0x25, 0xF5, 0xA5, 0x55, 0x29, 0x0B, 0xBE, 0x0F, 0xA7,
+ 0x58, 0x1A, 0x1C, 0x4E, 0x0E, 0x0E, 0x2E, 0x89, 0xA7, 0xA7, 0x57, 0x57, 0x42, 0x67, 0xC4, 0x84,
+ 0xD0, 0x4B, 0x29, 0xA6, 0xE1, 0xEC, 0xE3, 0xA2, 0xC8, 0x56, 0x60, 0x70, 0x96, 0xC5, 0x59, 0xC1,
+ 0xAC, 0x4E, 0x57, 0x5A, 0x67, 0xA9, 0x28, 0xF5, 0x26, 0x96, 0x96, 0x4D, 0xBE, 0x9E, 0x1C, 0x4C,
+ 0xB3, 0x68, 0x23, 0x3E, 0xD7, 0x76, 0xF5, 0x78, 0xD7, 0x50, 0x7C, 0xF9, 0x82, 0x7F, 0x46, 0xE2,
+ 0x4E, 0x88, 0xFE, 0x43, 0xF1, 0x74, 0x19, 0xA6, 0x0B, 0xB9, 0x9F, 0xC2, 0x52, 0x16, 0x52, 0x3C,
+ 0xEC, 0x1F, 0x58, 0x2A, 0x9F, 0x85, 0x45, 0xB1, 0x5E, 0x2A, 0x2D, 0x47, 0x90, 0xA5, 0x58, 0xA8,
+ 0x74, 0x28, 0xCE, 0xF3, 0x5B, 0x87, 0xED, 0xCA, 0x32, 0xAB, 0xE5, 0xAD, 0xB6, 0x48, 0x54, 0x5A,
+ 0xAA, 0x48, 0x5A, 0x4E, 0x4B, 0x92, 0x88, 0xB7, 0x33, 0xFB, 0x61, 0x14, 0x59, 0x2C, 0x44, 0x26,
+ 0x0F, 0xA6, 0x19, 0x80, 0x92, 0x1E, 0xEF, 0xFE, 0xCC, 0x48, 0x7A, 0x61, 0xAC, 0x16, 0xA0, 0x11,
+ 0xCB, 0xB9, 0xDE, 0x52, 0x3C, 0xC9, 0x6F, 0xC5, 0xC0, 0xD1, 0x7C, 0x4C, 0x10, 0xC2, 0x6C, 0x35,
+ 0x84, 0x41, 0x83, 0x98, 0xA0, 0x3D, 0x4C, 0xA6, 0x90, 0xD1, 0x6A, 0x26, 0x6B, 0x94, 0x1C, 0x21,
+ 0xB2, 0x5E, 0xA8, 0x52, 0x59, 0x80, 0x5A, 0xA4, 0xCA, 0x3C, 0x0E, 0x37, 0x43, 0x31, 0x8F, 0x25,
+ 0xE4, 0x61, 0xBA, 0x3D, 0x30, 0x9A, 0x94, 0x43, 0x31, 0x83, 0x89, 0x65, 0x31, 0x12, 0x1F, 0x56,
+ 0xA5, 0x56, 0xF3, 0x4D, 0xCF, 0x5A, 0x7D, 0xFB, 0xC0, 0x70, 0xF2, 0x02, 0x3B, 0xC5, 0x16, 0xE7,
+ 0x9C, 0xA4, 0x4F, 0xC2, 0x85, 0x91, 0x95, 0x38, 0xEB, 0x1A, 0xB4, 0x82, 0xD1, 0x3A, 0x36, 0x0D,
+ 0x8E, 0xFD, 0x6C, 0xA9, 0x64, 0x01, 0xD6, 0x0C, 0xE3, 0xBD, 0x42, 0x2D, 0x96, 0xA0, 0x79, 0x3C,
+ 0xD8, 0xEA, 0xFB, 0xB5, 0x11, 0x89, 0x28, 0x11, 0x2A, 0x43, 0x6D, 0x2F, 0xA6, 0x48, 0xDD, 0xEC,
+ 0x55, 0x69, 0x5D, 0x87, 0x3B, 0xCA, 0x5B, 0x2B, 0xBD, 0x04, 0x7A, 0xE6, 0xB2, 0xC2, 0x04, 0xF4,
+ 0x97, 0x7D, 0xEB, 0x65, 0xC6, 0x53, 0xDF, 0xBD, 0x7E, 0xF5, 0x77, 0xAD, 0xF3, 0xB7, 0xF2, 0xB7,
+ 0x95, 0x2C, 0x35, 0x73, 0x53, 0xCA, 0x34, 0x42, 0xE8, 0x88, 0x6F, 0x9F, 0x5F, 0x43, 0xFD, 0xBC,
+ 0xEE, 0xFC, 0x73, 0x56, 0xA8, 0x5C, 0x4F, 0x6E, 0xC2, 0x42, 0xDC, 0x2E, 0xB1, 0x4B, 0x8C, 0x45,
+ 0x2A, 0xD7, 0x2D, 0x1C, 0x7E, 0x67, 0x04, 0x1A, 0x06, 0xB2, 0xDA, 0x32, 0x5F, 0xA5, 0x33, 0xAD,
+ 0xE0, 0x88, 0x0B, 0xA9, 0x09, 0xBF, 0x0F, 0xE1, 0x3B, 0x10, 0x8A, 0xD1, 0x04, 0x59, 0x2E, 0x53,
+ 0xDF, 0x03, 0x3D, 0x0F, 0x5A, 0x2E, 0x16, 0xE2, 0xC8, 0x7B, 0xE4, 0x89, 0x23, 0xC6, 0xFD, 0x2C,
+ 0xD4, 0xD2, 0xEF, 0x04, 0xD8, 0x76, 0xAD, 0x12, 0x5C, 0x75, 0x85, 0x2E, 0x56, 0xB2, 0x33, 0xB2,
+ 0x3B, 0x19, 0x57, 0x47, 0xDC, 0x6D, 0x29, 0x1A, 0xB1, 0x5E, 0xB2, 0x36, 0x4B, 0x5D, 0xC8, 0x30,
+ 0x11, 0x7E, 0x18, 0x91, 0xF5, 0x49, 0x3D, 0x9B, 0x6C, 0x85, 0xE8, 0x9B, 0xE9, 0x55, 0x18, 0xBB,
+ 0xA7, 0xDF, 0xBF, 0x7D, 0xD5, 0x31, 0xE2, 0x71, 0xDC, 0x65, 0x69, 0x9C, 0x85, 0xD1, 0xF8, 0xB0,
+ 0xD4, 0x61, 0xA1, 0xAF, 0x18, 0x04, 0x12, 0x21, 0xB2, 0x2F, 0xC9, 0x0C, 0xAC, 0xBB, 0xB1, 0x97,
+ 0x67, 0xA5, 0x22, 0x71, 0x86, 0x85, 0x8C, 0x43, 0xAD, 0x6E, 0x10, 0x51, 0xCE, 0x07, 0x55, 0x1A,
+ 0x43, 0xD5, 0xBD, 0x69, 0x9C, 0xCD, 0x3E, 0x8E, 0xEA, 0x46, 0x63, 0x9B, 0x79, 0x93, 0x03, 0x21,
+ 0x2E, 0xC9, 0x35, 0x54, 0x34, 0xF6, 0x0C, 0x07, 0x9E, 0x28, 0x8B, 0xD9, 0xD8, 0xF3, 0x1C, 0x72,
+ 0xCE, 0x40, 0xC3, 0xB3, 0x01, 0xF9, 0x8A, 0x27, 0x66, 0x45, 0x56, 0x96, 0x19, 0xFC, 0x47, 0xA5,
+ 0x63, 0x2F, 0x4C, 0xB3, 0x74, 0x93, 0x64, 0xAB, 0xD2, 0xE0, 0x21, 0x8E, 0x08, 0xCF, 0x3C, 0x2F,
+ 0xBF, 0xBB, 0x91, 0x05, 0xC8, 0x7B, 0x3B, 0x1C, 0x86, 0xD3, 0x32, 0x8B, 0x57, 0x14, 0xF3, 0x3A,
+ 0xCB, 0x87, 0xC6, 0x01, 0x89, 0x15, 0x7B, 0xB9, 0x4D, 0x1C, 0xC3, 0x62, 0x31, 0x0D, 0xFD, 0x41,
+ 0x97, 0x7F, 0x83, 0x73, 0xA8, 0xD8, 0xA4, 0x8C, 0x2F, 0xE7, 0xF3, 0xF9, 0x48, 0xE4, 0x88, 0x77,
+ 0x38, 0xC5, 0xF0, 0x0C, 0xE1, 0x6B, 0x77, 0x66, 0x45, 0x84, 0xEC, 0x57, 0x84, 0x91, 0x5A, 0x95,
+ 0xC3, 0x0B, 0x5A, 0x9A, 0xC3, 0xD1, 0x7A, 0xA5, 0xFA, 0x24, 0x87, 0xC7, 0xDB, 0xFB, 0x79, 0x98,
+ 0xA8, 0x78, 0x33, 0x4C, 0xB2, 0x34, 0x2B, 0xF3, 0x70, 0x26, 0xA1, 0x83, 0x17, 0x6F, 0xAE, 0x86,
+ 0xE2, 0x12, 0x77, 0xA9, 0x63, 0xFF, 0x87, 0x30, 0x5E, 0x49, 0x6F, 0x32, 0x08, 0x06, 0xB0, 0x24,
+ 0xD6, 0x27, 0x97, 0xD3, 0x62, 0xF2, 0x2A, 0xD4, 0x75, 0x30, 0x68, 0xDA, 0x82, 0xF5, 0x1C, 0x50,
+ 0x1F, 0x1A, 0x80, 0x65, 0xCC, 0x3F, 0x63, 0x79, 0x63, 0x32, 0x38, 0x6E, 0x08, 0xEE, 0x86, 0xE0,
+ 0xBB, 0x28, 0x91, 0x5E, 0x29, 0x0C, 0x92, 0x55, 0xAC, 0x15, 0xEE, 0xB5, 0xB3, 0x3C, 0xFC, 0x61,
+ 0xE1, 0x92, 0x1E, 0x9C, 0x0B, 0x16, 0x4F, 0x72, 0x8E, 0xF7, 0x92, 0x3C, 0x39, 0x45, 0xDA, 0xC9,
+ 0xE6, 0x42, 0x42, 0xB1, 0x1B, 0x31, 0x2F, 0x50, 0x3C, 0x1A, 0x41, 0x00, 0xFD, 0x53, 0x1C, 0x80,
+ 0x29, 0x44, 0xC1, 0x67, 0x40, 0xCE, 0x91, 0xED, 0x87, 0x02, 0x45, 0xA1, 0xD0, 0x14, 0xE9, 0xF2,
+ 0x1B, 0xF8, 0xF2, 0x42, 0x22, 0x03, 0xBD, 0xFF, 0xA5, 0x0B, 0xB0, 0x52, 0x5F, 0xC9, 0xDF, 0xF8,
+ 0x79, 0x54, 0x64, 0x79, 0x2E, 0x23, 0x5C, 0x8B, 0xBB, 0x11, 0xD0, 0x54, 0xB1, 0x51, 0x6E, 0xD2,
+ 0xD9, 0x53, 0xF2, 0x1B, 0x9F, 0x42, 0x43, 0xF4, 0xFB, 0xE2, 0x9F, 0xD7, 0x6F, 0x7A, 0xB1, 0xFA,
+ 0x28, 0x87, 0xE2, 0xA3, 0x94, 0x39, 0x73, 0x6A, 0x08, 0x11, 0x67, 0x74, 0x37, 0x07, 0x5E, 0x8A,
+ 0x5B, 0x93, 0xFA, 0x35, 0x38, 0x03, 0x42, 0xC3, 0x99, 0x1E, 0x80, 0xB1, 0x5C, 0x16, 0x08, 0xE9,
+ 0x24, 0x84, 0x30, 0x41, 0x9A, 0xAD, 0xE1, 0xC9, 0xFC, 0x7C, 0x2E, 0xF5, 0x6C, 0xE9, 0x7B, 0x7D,
+ 0x12, 0xDB, 0xEB, 0x04, 0xC0, 0x94, 0xFA, 0x8E, 0x0D, 0xBF, 0x20, 0xEA, 0x85, 0xD4, 0xAB, 0x22,
+ 0x15, 0x45, 0x40, 0x1E, 0x8C, 0x6D, 0xE2, 0xAE, 0x0D, 0xA6, 0x01, 0xC6, 0xC8, 0x2C, 0xB9, 0xE3,
+ 0xFB, 0xC9, 0x09, 0x52, 0x53, 0x00, 0xBD, 0x88, 0x87, 0x63, 0x81, 0xC2, 0x79, 0x3E, 0x62, 0xE9,
+ 0x5E, 0xB9, 0xF2, 0xD8, 0x94, 0x80, 0xD4, 0x26, 0xB2, 0x15, 0xC7, 0xEB, 0x3C, 0x8B, 0xE3, 0x6C,
+ 0x2D, 0x66, 0xA4, 0x15, 0x28, 0x4E, 0xCD, 0xB5, 0x45, 0xA8, 0xE6, 0xC2, 0x07, 0xC9, 0x1E, 0x89,
+ 0x79, 0xE9, 0xD0, 0x13, 0xE3, 0x8E, 0xD2, 0x58, 0xD8, 0xC7, 0x23, 0x5E, 0xB2, 0x6A, 0x1B, 0x1B,
+ 0x87, 0x78, 0x99, 0x6A, 0xE2, 0xBF, 0x0F, 0x57, 0x1E, 0x0C, 0x00, 0xE5, 0x03, 0xCB, 0x11, 0x36,
+ 0xD0, 0xD2, 0x09, 0x64, 0x65, 0x22, 0x77, 0xCC, 0xFD, 0x5D, 0xDD, 0x42, 0x59, 0xFA, 0x82, 0x1C,
+ 0xC1, 0xFF, 0x90, 0x2F, 0x90, 0x88, 0xCA, 0x2E, 0x79, 0x8A, 0x53, 0x03, 0x51, 0x21, 0x83, 0x07,
+ 0xF9, 0xAA, 0x5C, 0xFA, 0x3B, 0x9A, 0x00, 0xFE, 0x1A, 0x1F, 0x60, 0xAC, 0xB4, 0xE4, 0xAD, 0x8E,
+ 0x48, 0xA0, 0x0A, 0x45, 0x2C, 0xD3, 0x85, 0x5E, 0x8A, 0x09, 0x01, 0x74, 0xB6, 0x98, 0xCB, 0x25,
+ 0x14, 0xE0, 0xB7, 0x36, 0x58, 0xD7, 0x12, 0x0F, 0x1E, 0x10, 0x37, 0xD8, 0x53, 0x5F, 0x3C, 0x12,
+ 0xC7, 0x66, 0xBF, 0x75, 0x3A, 0x71, 0x34, 0x66, 0xA8, 0x5E, 0x03, 0xAA, 0x27, 0x8E, 0x47, 0x95,
+ 0x0C, 0x6E, 0x91, 0x01, 0x47, 0x95, 0x3B, 0x51, 0xCE, 0x1A, 0x8B, 0x28, 0x9B, 0xAD, 0x12, 0x14,
+ 0x3D, 0x4A, 0xC8, 0xCF, 0x63, 0x49, 0x97, 0x4F, 0x36, 0x2F, 0x23, 0xDF, 0xA5, 0xB2, 0xCE, 0x76,
+ 0x43, 0x16, 0x47, 0xD8, 0x80, 0x6D, 0x01, 0xD2, 0x9B, 0x65, 0xD9, 0xDC, 0x60, 0x19, 0x49, 0x37,
+ 0x98, 0x61, 0x87, 0x96, 0xDF, 0x4D, 0x3F, 0xC8, 0x99, 0xC6, 0xBD, 0x4F, 0xE9, 0xFE, 0x49, 0x9C,
+ 0x4D, 0xFD, 0xF7, 0x50, 0x2F, 0x62, 0x06, 0x25, 0x6F, 0x93, 0xC3, 0xF5, 0x3D, 0x2E, 0x8D, 0xFD,
+ 0x0F, 0xB9, 0x5C, 0x78, 0x30, 0x4A, 0x4D, 0x7C, 0x90, 0x08, 0x38, 0x4F, 0x97, 0x3F, 0xA2, 0xDA,
+ 0xF9, 0x1E, 0x92, 0xEE, 0x74, 0xE8, 0x75, 0x3A, 0x8C, 0xBE, 0x90, 0x37, 0xD9, 0xC7, 0x1A, 0x7A,
+ 0x00, 0xEF, 0x1A, 0x74, 0xC9, 0x69, 0x82, 0xD3, 0x8A, 0xBF, 0x8C, 0x8A, 0x2E, 0x37, 0x89, 0xCE,
+ 0xA2, 0x24, 0x45, 0x02, 0x66, 0xF1, 0x20, 0x48, 0x42, 0x8A, 0x18, 0x62, 0xF1, 0xAD, 0x5C, 0x3C,
+ 0xBF, 0xCD, 0x7D, 0x02, 0x84, 0x7A, 0xBD, 0xE1, 0xCF, 0x3F, 0x97, 0x0F, 0xFD, 0x9F, 0x7F, 0x8E,
+ 0x8E, 0x3A, 0xA8, 0x5E, 0x9E, 0xF2, 0x1C, 0x83, 0x36, 0x82, 0x12, 0xF1, 0x68, 0xEB, 0x73, 0xC9,
+ 0xFB, 0xE3, 0x5F, 0x3A, 0x02, 0x91, 0xBF, 0xC3, 0x48, 0xA3, 0xDC, 0xD4, 0xE8, 0xAF, 0x8A, 0xB8,
+ 0xAE, 0x76, 0xC4, 0x41, 0x48, 0xF0, 0x81, 0xA9, 0x08, 0xCC, 0xC0, 0xC5, 0x71, 0xDF, 0x6A, 0x7F,
+ 0xAB, 0x99, 0x2F, 0xD6, 0x2A, 0x8D, 0xB2, 0x75, 0xC0, 0x81, 0x2E, 0xFE, 0xFD, 0x6F, 0xE1, 0x16,
+ 0xDE, 0x42, 0x60, 0x6A, 0x56, 0x0D, 0x29, 0x0A, 0x98, 0x3F, 0x34, 0xA9, 0x35, 0x19, 0x38, 0x19,
+ 0x59, 0xA1, 0x5C, 0x84, 0x98, 0x34, 0x82, 0x07, 0x3B, 0x29, 0x44, 0x96, 0x79, 0x33, 0x3D, 0x98,
+ 0x7C, 0x0C, 0x34, 0xF4, 0x28, 0xA0, 0x4A, 0x4B, 0xF4, 0xDE, 0xF2, 0xEA, 0x36, 0x4D, 0x10, 0xE4,
+ 0x74, 0x35, 0xB7, 0x7D, 0xC5, 0xF7, 0x2A, 0xD5, 0x17, 0x8F, 0x8B, 0x22, 0xDC, 0xF8, 0x83, 0x0A,
+ 0xA4, 0xD2, 0x18, 0x2B, 0xD5, 0xDF, 0x52, 0x11, 0xD4, 0x9C, 0xC6, 0x12, 0xB1, 0x4C, 0x0D, 0x42,
+ 0x6D, 0xD9, 0xA0, 0x45, 0xA3, 0x00, 0xB4, 0xBD, 0xE3, 0x51, 0x6D, 0x9D, 0xBA, 0x1D, 0x9F, 0x9D,
+ 0x1B, 0x8F, 0x90, 0x28, 0x14, 0xF4, 0x79, 0x8A, 0x74, 0x02, 0x16, 0x6C, 0x08, 0x62, 0xED, 0xE8,
+ 0xA8, 0x89, 0xCC, 0x28, 0x18, 0x20, 0xEF, 0xD5, 0x2F, 0x62, 0x8C, 0x7C, 0x76, 0x4A, 0xA1, 0xC7,
+ 0xF7, 0x14, 0x6E, 0x66, 0x6D, 0x50, 0x5F, 0x3B, 0xD9, 0x03, 0x77, 0x6A, 0xE1, 0xC8, 0x02, 0x86,
+ 0x35, 0x5A, 0x3D, 0x43, 0x59, 0x85, 0xA6, 0x3E, 0x3A, 0x05, 0x9B, 0x9F, 0xFA, 0x35, 0xD1, 0x26,
+ 0xF8, 0x4B, 0x81, 0xAD, 0xD6, 0x1A, 0x2D, 0x49, 0xE1, 0xAE, 0x56, 0x81, 0xD7, 0xC8, 0xDD, 0xCF,
+ 0xE4, 0x2C, 0x63, 0x1D, 0x07, 0x11, 0x5F, 0x11, 0xE7, 0x41, 0xB9, 0x9A, 0x86, 0x46, 0xAF, 0x5D,
+ 0xA2, 0xDE, 0xE9, 0xB4, 0x71, 0x40, 0x7A, 0x72, 0xFC, 0x76, 0x74, 0x78, 0x4F, 0x4D, 0xF7, 0xDC,
+ 0x7B, 0xC5, 0xDA, 0xF1, 0x1A, 0xFB, 0xAC, 0x5A, 0x5C, 0xF2, 0xBA, 0x64, 0xB9, 0x8E, 0x08, 0xD5,
+ 0x3E, 0x4E, 0x5D, 0x2A, 0x65, 0x76, 0x62, 0x4C, 0x5E, 0x24, 0x56, 0xB7, 0xB6, 0xA7, 0xBB, 0x87,
+ 0xFC, 0xBB, 0xDE, 0xB5, 0x2B, 0xD4, 0xDE, 0x3D, 0x00, 0x8C, 0xB5, 0x87, 0x04, 0xE6, 0x35, 0xA5,
+ 0x32, 0x6E, 0xD5, 0xA0, 0x66, 0x09, 0x6D, 0xA1, 0x9C, 0xA2, 0xEF, 0x76, 0x7C, 0x6D, 0x95, 0xE4,
+ 0x0D, 0x57, 0x73, 0xE5, 0x91, 0x19, 0x08, 0xE8, 0x9F, 0xBF, 0xAF, 0x8C, 0xB6, 0xB4, 0x53, 0x04,
+ 0x51, 0x96, 0xC2, 0x37, 0xF5, 0xB2, 0x40, 0x51, 0xF3, 0x50, 0xD5, 0x4A, 0x19, 0x79, 0x6D, 0xDD,
+ 0xA7, 0xD4, 0xCA, 0xEF, 0x44, 0x40, 0x4D, 0xB3, 0x47, 0x28, 0xCB, 0x37, 0x24, 0xB4, 0x5D, 0x68,
+ 0xC8, 0x49, 0xBB, 0xD1, 0x16, 0x6B, 0xDA, 0x80, 0xB2, 0x5D, 0xDD, 0xDA, 0x2D, 0xDD, 0x9A, 0x73,
+ 0xEF, 0xD1, 0x0F, 0x81, 0xD7, 0x57, 0x6D, 0x90, 0xD5, 0x97, 0xAC, 0xE8, 0x46, 0x25, 0x35, 0xDD,
+ 0x55, 0xD7, 0x4E, 0x7B, 0x7B, 0x00, 0xD1, 0x44, 0xCC, 0x38, 0x91, 0x56, 0x5A, 0x22, 0xFF, 0x2F,
+ 0x4D, 0x73, 0x8F, 0x92, 0xEF, 0xD7, 0xD2, 0x60, 0xD7, 0x56, 0xC7, 0x7D, 0x75, 0x78, 0x95, 0x47,
+ 0x28, 0x1D, 0xE8, 0x0F, 0xD1, 0xA5, 0x6D, 0x2A, 0xC3, 0x70, 0xE2, 0x6B, 0xD5, 0xD0, 0xA6, 0xEB,
+ 0x91, 0x7A, 0xD1, 0x4C, 0x6B, 0x49, 0x01, 0xB7, 0x2D, 0xAB, 0xEC, 0x10, 0xC8, 0x73, 0x78, 0xB2,
+ 0xE5, 0x2C, 0x84, 0xAA, 0x6A, 0x9D, 0x50, 0x88, 0x2A, 0x39, 0x1D, 0x55, 0x62, 0x12, 0xA6, 0xFC,
+ 0x9C, 0x5A, 0x2C, 0x83, 0xEF, 0xFD, 0xEB, 0x50, 0x2F, 0x83, 0x79, 0x9C, 0x65, 0x85, 0x6F, 0x56,
+ 0x9C, 0xB5, 0x1E, 0x0A, 0xEA, 0xA6, 0x7F, 0xA9, 0x6D, 0xFB, 0xE6, 0xBC, 0xB5, 0x2D, 0x51, 0x69,
+ 0x6B, 0x13, 0x2A, 0x72, 0x57, 0xFC, 0x2E, 0xCA, 0x6F, 0xCE, 0x3B, 0x0E, 0xE9, 0xBD, 0x19, 0xBC,
+ 0xEA, 0x98, 0x3B, 0x81, 0x4A, 0x31, 0xFF, 0x5D, 0x1B, 0xCF, 0x02, 0xDF, 0x81, 0xCE, 0x5E, 0xA8,
+ 0x5B, 0x19, 0x21, 0xB1, 0x52, 0x0D, 0xE9, 0xD3, 0xB8, 0x05, 0xBE, 0x5A, 0xCB, 0x18, 0x74, 0xA9,
+ 0x6F, 0x10, 0x9E, 0x6D, 0x5E, 0x6C, 0x13, 0xE1, 0xCC, 0x51, 0xEB, 0x57, 0x69, 0x09, 0x66, 0x7C,
+ 0x49, 0xE3, 0x30, 0xFC, 0xCC, 0xAF, 0x1E, 0x75, 0xC5, 0xB9, 0xEB, 0x71, 0xEA, 0xCF, 0x1B, 0x06,
+ 0x74, 0x96, 0x3E, 0x68, 0x4F, 0x71, 0x98, 0x13, 0xDC, 0x5C, 0xC5, 0xF3, 0xAC, 0xE0, 0x59, 0x80,
+ 0xB2, 0x76, 0xB4, 0x41, 0xFD, 0x55, 0x33, 0xE3, 0x08, 0x34, 0xAC, 0xB6, 0x5A, 0xF3, 0x96, 0xA7,
+ 0x00, 0x51, 0xA3, 0xAA, 0xFE, 0xEE, 0xF4, 0xCA, 0x50, 0x76, 0x30, 0x4D, 0x29, 0xB4, 0x37, 0xF0,
+ 0x4A, 0x2D, 0x67, 0xE6, 0xB4, 0x65, 0x2C, 0xEA, 0xBE, 0x5B, 0xEF, 0x46, 0x97, 0xAA, 0xE4, 0x4C,
+ 0xB0, 0xB9, 0x22, 0x70, 0x4A, 0xEF, 0x67, 0x94, 0xF1, 0x79, 0x9D, 0x30, 0xAC, 0x4A, 0x5A, 0x3B,
+ 0xA1, 0x8E, 0x6E, 0x9B, 0x18, 0xEE, 0xB5, 0x5D, 0x35, 0x14, 0x35, 0x6D, 0x67, 0xA9, 0x94, 0x79,
+ 0x96, 0x96, 0xF2, 0xBA, 0x16, 0xAD, 0xB6, 0x67, 0x6D, 0x70, 0x5F, 0x1B, 0xAB, 0xBD, 0x3E, 0x10,
+ 0x7A, 0x6E, 0x7A, 0xAE, 0x01, 0x99, 0x09, 0xBA, 0x32, 0xE9, 0x8E, 0x8D, 0xA0, 0xBA, 0xEE, 0xB6,
+ 0x4F, 0xAD, 0xA9, 0x73, 0xD7, 0x5C, 0x2F, 0xD3, 0x59, 0xBC, 0x8A, 0xA4, 0xF8, 0x90, 0x6D, 0xC8,
+ 0xA5, 0x83, 0x0F, 0xA5, 0x88, 0xD5, 0xB4, 0x08, 0x31, 0x3F, 0xD5, 0xCC, 0xC3, 0xD3, 0xEE, 0x61,
+ 0x7F, 0x0B, 0x74, 0x38, 0x69, 0x23, 0xFA, 0x47, 0x06, 0x95, 0x2B, 0x74, 0xFC, 0xDB, 0x93, 0x0B,
+ 0x46, 0x60, 0xE7, 0xDD, 0xC3, 0x0F, 0xF6, 0xF9, 0x33, 0x75, 0x73, 0x68, 0x07, 0x5E, 0x73, 0x88,
+ 0x37, 0x24, 0xF5, 0xD2, 0xE4, 0xB9, 0x94, 0xE6, 0xC0, 0xC5, 0xDE, 0xBA, 0xC3, 0xA7, 0x81, 0x08,
+ 0x57, 0x3A, 0x1B, 0x1D, 0x4E, 0x1A, 0x23, 0xE3, 0x3F, 0xC2, 0x9B, 0xF0, 0xCA, 0xF0, 0x46, 0xBE,
+ 0xE5, 0xB0, 0x57, 0x86, 0xC6, 0xFC, 0xAE, 0x37, 0x6D, 0x0F, 0xC3, 0xFC, 0x52, 0xB1, 0xC9, 0xD3,
+ 0x61, 0x29, 0x16, 0x19, 0xAA, 0x1A, 0x4F, 0x34, 0xFD, 0x75, 0x29, 0x7E, 0x94, 0xD3, 0x2B, 0x04,
+ 0x80, 0xD4, 0x5D, 0x41, 0xC2, 0x92, 0x28, 0x45, 0x16, 0x0B, 0x55, 0xDA, 0xC1, 0x2D, 0x8E, 0x69,
+ 0xF6, 0x0E, 0x0C, 0xAA, 0x2B, 0xD8, 0x1D, 0xFD, 0x8B, 0x34, 0xDB, 0x0D, 0xD6, 0x24, 0xBB, 0x91,
+ 0x18, 0x31, 0x30, 0x60, 0x26, 0x19, 0x06, 0x24, 0x52, 0xD8, 0xF2, 0x13, 0x8D, 0x58, 0xB0, 0x12,
+ 0xB0, 0x45, 0xC2, 0x7F, 0xB4, 0xFC, 0x34, 0x76, 0x24, 0x73, 0x9A, 0x9A, 0xE8, 0x2C, 0xA3, 0x6B,
+ 0x30, 0x9A, 0xC3, 0xB3, 0x9C, 0x5A, 0xEC, 0xC8, 0x0E, 0xB1, 0x8C, 0x41, 0x22, 0xC1, 0x4E, 0x25,
+ 0x21, 0x2D, 0x91, 0x83, 0xCC, 0xF9, 0x50, 0x58, 0x78, 0x88, 0x74, 0xB8, 0x6E, 0x0F, 0x03, 0x0B,
+ 0xCF, 0xC2, 0xE8, 0x8B, 0x10, 0xB7, 0x80, 0xE9, 0xC0, 0x43, 0x65, 0x99, 0x7A, 0x34, 0x34, 0x23,
+ 0x13, 0x28, 0x6D, 0xE7, 0x5E, 0xE0, 0xE2, 0xB9, 0x77, 0xF9, 0x69, 0xB8, 0x6D, 0x6F, 0xB9, 0x64,
+ 0xBD, 0x7D, 0x75, 0x05, 0x1A, 0xB3, 0xE5, 0x9B, 0x10, 0x5A, 0x29, 0xFD, 0xAA, 0x63, 0x2D, 0x79,
+ 0x95, 0x8F, 0x72, 0x7C, 0x6F, 0xF9, 0x89, 0xDA, 0x74, 0xF4, 0xA5, 0xE7, 0x03, 0x2E, 0xE3, 0x86,
+ 0x27, 0x8C, 0xCD, 0x74, 0x5F, 0xDA, 0x41, 0xF9, 0x96, 0xFF, 0x6E, 0xF8, 0x2F, 0xDC, 0x54, 0xBF,
+ 0x1B, 0x8A, 0x74, 0x15, 0xC7, 0xE6, 0xE6, 0x27, 0x77, 0x43, 0xF3, 0x0A, 0x83, 0x30, 0xDF, 0x6E,
+ 0x75, 0x5D, 0x9A, 0xAB, 0xD6, 0x88, 0x0D, 0xB6, 0xD1, 0xC2, 0xA4, 0x18, 0x09, 0x9A, 0x55, 0xC3,
+ 0x76, 0xC7, 0x95, 0xCD, 0x76, 0xCB, 0x06, 0x2C, 0x6A, 0xF2, 0x45, 0x05, 0xE3, 0x7B, 0x20, 0xD2,
+ 0xE7, 0xD4, 0x59, 0x09, 0xB9, 0x24, 0x4B, 0x51, 0x42, 0x5D, 0x97, 0xAE, 0x39, 0x5A, 0x97, 0xC1,
+ 0x54, 0xA5, 0x08, 0x82, 0x6B, 0x4C, 0x33, 0xC0, 0xE1, 0x71, 0xE7, 0x85, 0x72, 0x3B, 0x97, 0x85,
+ 0x57, 0x81, 0x64, 0x29, 0x45, 0x6B, 0x2B, 0xBB, 0xB0, 0xC5, 0x98, 0xF0, 0xBA, 0x1C, 0xF1, 0x0D,
+ 0xAB, 0x81, 0x18, 0x81, 0x68, 0xBC, 0x72, 0x65, 0xC2, 0xD7, 0x05, 0x3E, 0x63, 0xE2, 0xBE, 0xE2,
+ 0x5E, 0x54, 0x66, 0x6B, 0xAD, 0xE6, 0x6E, 0x75, 0xD2, 0xA5, 0x78, 0x19, 0x38, 0x6C, 0x77, 0x2D,
+ 0xC5, 0x19, 0x52, 0x56, 0x6B, 0x84, 0xCE, 0x38, 0x8A, 0xC5, 0x58, 0x29, 0x0A, 0xD3, 0xEE, 0xFD,
+ 0x27, 0x01, 0xA4, 0x6C, 0xDA, 0x7A, 0x8B, 0x54, 0x38, 0xAE, 0x49, 0x84, 0x3C, 0x49, 0x37, 0x9B,
+ 0xC6, 0xF2, 0x4F, 0xB4, 0x4C, 0xE8, 0x7A, 0xBC, 0x44, 0x86, 0x46, 0x57, 0xD9, 0xF0, 0xE2, 0x3D,
+ 0x76, 0x0A, 0x15, 0xE5, 0xC9, 0x6A, 0xC3, 0x91, 0x99, 0xF1, 0xFB, 0x2E, 0x7E, 0x7A, 0x84, 0x71,
+ 0xCB, 0x0C, 0x83, 0x4F, 0xC4, 0xC0, 0xA9, 0xC8, 0xC9, 0xD4, 0xD4, 0xCF, 0x15, 0xF7, 0xA6, 0x04,
+ 0xDB, 0x69, 0xCF, 0x40, 0x15, 0xA1, 0x31, 0x23, 0x6E, 0x58, 0x89, 0x25, 0x1D, 0xD5, 0xE4, 0x31,
+ 0x4B, 0x9B, 0xA6, 0x2E, 0x60, 0x15, 0x2B, 0xFE, 0xBA, 0x5D, 0x40, 0x2A, 0x5F, 0x0B, 0xBE, 0x7B,
+ 0xF3, 0xFC, 0x9F, 0xCD, 0x89, 0xCA, 0x1C, 0x49, 0x8D, 0xDD, 0x29, 0x69, 0xF8, 0x83, 0x92, 0x6B,
+ 0x8E, 0x40, 0xEE, 0x17, 0x9F, 0xB0, 0x7F, 0xF9, 0x17, 0x68, 0x82, 0x39, 0x1D, 0x00, 0xFD, 0xAF,
+ 0xBC, 0xE3, 0x57, 0x4D, 0xF1, 0x63, 0x0E, 0x85, 0x91, 0x8F, 0x7E, 0xCD, 0x8B, 0x4C, 0x67, 0xB3,
+ 0x2C, 0x0E, 0x96, 0xAE, 0xE9, 0x25, 0x28, 0x6A, 0x19, 0xA9, 0xF9, 0x3C, 0xFE, 0x8A, 0x46, 0x84,
+ 0xA3, 0x23, 0x23, 0xC2, 0x6F, 0xE2, 0x81, 0x18, 0xDC, 0xCE, 0xF1, 0xD3, 0x28, 0x24, 0xB5, 0x3D,
+ 0xC8, 0x02, 0x17, 0xFE, 0x49, 0xD7, 0x48, 0x7E, 0xCF, 0xE3, 0x53, 0xF3, 0x78, 0xB3, 0xFB, 0x98,
+ 0x28, 0x9E, 0x9E, 0xF8, 0x67, 0xB6, 0xF5, 0xE1, 0x23, 0x21, 0x9F, 0x1C, 0xA0, 0x7E, 0x76, 0xD2,
+ 0x11, 0x93, 0xC9, 0x84, 0xE3, 0xBD, 0xCE, 0x81, 0x55, 0x1F, 0x57, 0x33, 0x83, 0xCF, 0x44, 0x98,
+ 0x6B, 0x3C, 0x85, 0x8C, 0x11, 0x13, 0x4E, 0x7F, 0xB1, 0xD4, 0x7F, 0xA2, 0x07, 0xD8, 0x5F, 0x47,
+ 0xB7, 0xB9, 0xFC, 0xD1, 0xED, 0x98, 0x82, 0xDF, 0xF8, 0x33, 0x82, 0xFE, 0xC1, 0xA6, 0xBA, 0xDF,
+ 0xB4, 0xD8, 0x6B, 0xD7, 0x5A, 0x13, 0x5D, 0xED, 0x08, 0x7B, 0x8D, 0x8C, 0xEF, 0x73, 0xF2, 0xAF,
+ 0x87, 0xD9, 0x6D, 0xFD, 0xD4, 0x8A, 0x9F, 0x42, 0xB5, 0x94, 0x3B, 0x07, 0xC6, 0xB4, 0xDF, 0x42,
+ 0x98, 0x77, 0xBD, 0xF0, 0x16, 0x95, 0x85, 0x5B, 0xFC, 0x6A, 0xE3, 0x66, 0x77, 0xE3, 0xA6, 0xBD,
+ 0xF1, 0xA7, 0xF6, 0x46, 0x4E, 0x87, 0x55, 0x24, 0x74, 0x6A, 0x39, 0x86, 0x19, 0xB6, 0xE9, 0x1F,
+ 0xA5, 0xEF, 0x8A, 0x8B, 0x94, 0xD1, 0x9F, 0xBB, 0xF5, 0xBD, 0x5A, 0x69, 0x86, 0xB6, 0x8C, 0x10,
+ 0x9E, 0x56, 0x3A, 0x96, 0xDE, 0x50, 0x54, 0x4F, 0xBD, 0xAE, 0x79, 0xC0, 0x45, 0xDB, 0xE3, 0x32,
+ 0x6D, 0x57, 0x4C, 0xE1, 0x6E, 0x2C, 0x29, 0x6A, 0x48, 0x50, 0x84, 0x5F, 0xA8, 0x38, 0x7E, 0x4A,
+ 0x47, 0xD2, 0x84, 0x49, 0x7C, 0x79, 0x71, 0xF2, 0xF8, 0xF9, 0xE9, 0x89, 0xD7, 0x02, 0xC2, 0xEC,
+ 0x90, 0x7D, 0x94, 0x35, 0xB0, 0xC1, 0xC5, 0xF9, 0xD3, 0xB3, 0x67, 0x0E, 0x0C, 0x0D, 0xD3, 0xEF,
+ 0x82, 0x91, 0x8C, 0x5D, 0x67, 0x0A, 0x16, 0xB9, 0x5E, 0x31, 0xDA, 0x5D, 0x6C, 0x23, 0xC1, 0xDE,
+ 0xAF, 0x38, 0x42, 0x79, 0xBE, 0xAF, 0xBF, 0x7D, 0xA6, 0x16, 0x4A, 0x87, 0xB1, 0xF8, 0x94, 0x65,
+ 0xC9, 0x50, 0x60, 0x0C, 0x89, 0xEC, 0xAB, 0x27, 0xAA, 0xCA, 0xB4, 0xD8, 0x15, 0xB3, 0x98, 0xB4,
+ 0x6C, 0x6B, 0xBC, 0x79, 0x47, 0xA4, 0x33, 0x7E, 0xEF, 0x54, 0xE0, 0x5E, 0x9B, 0xAE, 0x24, 0x37,
+ 0xEF, 0xA6, 0xC6, 0xE6, 0x75, 0xD4, 0xE4, 0x5F, 0xD8, 0x29, 0x2E, 0x55, 0x9A, 0xD3, 0x19, 0x2A,
+ 0x8A, 0xCE, 0xD8, 0x2B, 0xA8, 0x75, 0xF5, 0xF8, 0x14, 0x9D, 0xD0, 0x7A, 0x22, 0xA1, 0xB7, 0x09,
+ 0x48, 0x8C, 0x1E, 0xBD, 0xD5, 0x1C, 0x7B, 0x67, 0x74, 0x55, 0x6A, 0x99, 0x8F, 0xBD, 0x93, 0x73,
+ 0xCF, 0x78, 0x83, 0x7D, 0x8E, 0x72, 0xC2, 0x8D, 0xEF, 0xD8, 0x83, 0xE4, 0x84, 0xD9, 0x34, 0xBA,
+ 0x0C, 0xD2, 0xF1, 0xD0, 0x48, 0xE5, 0x3B, 0x67, 0xE2, 0x45, 0xA6, 0xB8, 0x37, 0x30, 0x62, 0x01,
+ 0x0B, 0x97, 0xF2, 0xF3, 0x81, 0x29, 0xE6, 0xD4, 0x57, 0xB4, 0xCE, 0xBD, 0xA1, 0xA6, 0xB7, 0x99,
+ 0xAA, 0x6A, 0xCB, 0x9F, 0x8B, 0xCE, 0x7D, 0xB1, 0xE9, 0x02, 0x13, 0x5C, 0x8C, 0xC1, 0xC5, 0x03,
+ 0x70, 0xC9, 0x21, 0x89, 0xEB, 0x80, 0xB8, 0xA1, 0x28, 0xED, 0xBA, 0x85, 0xDB, 0xC6, 0xDD, 0xE6,
+ 0x0F, 0x7B, 0xE3, 0x1A, 0xBF, 0x46, 0x11, 0x84, 0xD1, 0xF1, 0x5C, 0x51, 0xA8, 0x85, 0x1C, 0x3F,
+ 0xDF, 0xE6, 0xFA, 0x2D, 0xC8, 0xD8, 0x9C, 0xEB, 0x7E, 0xB6, 0x6C, 0x8C, 0x49, 0x27, 0x23, 0xC3,
+ 0x85, 0xBB, 0x31, 0xC5, 0xA5, 0xD2, 0x8C, 0xE3, 0xE1, 0x8F, 0x0F, 0xEB, 0xA8, 0xFC, 0x9B, 0xC0,
+ 0xAC, 0xBC, 0x53, 0xD6, 0x5B, 0x9D, 0x1D, 0x2E, 0x76, 0xE6, 0x63, 0x9A, 0xB1, 0xC6, 0xA6, 0x6A,
+ 0x3E, 0xA4, 0x7F, 0xA8, 0x9D, 0x6E, 0x93, 0xC9, 0x1B, 0x6F, 0xE8, 0x1D, 0x8A, 0x7D, 0x01, 0x01,
+ 0x0E, 0x4B, 0x7A, 0x67, 0xB8, 0xCC, 0xD6, 0x29, 0xBD, 0x35, 0xA7, 0xC2, 0x9F, 0x20, 0x50, 0x65,
+ 0xA5, 0x15, 0x92, 0xAF, 0x96, 0xCE, 0xAB, 0x81, 0x97, 0x08, 0xD8, 0x44, 0x0F, 0x1F, 0xA4, 0x32,
+ 0xE3, 0x8C, 0xE2, 0x4B, 0x9B, 0xEA, 0xDF, 0x81, 0x34, 0x7B, 0x1B, 0x44, 0x82, 0xA4, 0x3F, 0x52,
+ 0xB6, 0x40, 0x01, 0xA7, 0x79, 0x1A, 0xAC, 0x11, 0xA3, 0x9D, 0xEA, 0xB4, 0xD5, 0x2A, 0xEF, 0xCF,
+ 0x53, 0xDA, 0xD4, 0x29, 0xFD, 0xD4, 0xA4, 0xF4, 0x77, 0xCE, 0x42, 0xF7, 0x90, 0x6A, 0x1A, 0x65,
+ 0x37, 0xAA, 0xAF, 0x30, 0x8F, 0xC6, 0x52, 0xBC, 0x7A, 0xFE, 0x0C, 0xA1, 0xBA, 0xA0, 0x4B, 0xFB,
+ 0x12, 0x7E, 0x5F, 0xAC, 0x1E, 0x5C, 0xDA, 0x87, 0xFC, 0x86, 0x4B, 0x46, 0x4F, 0xF8, 0xAE, 0x7A,
+ 0x8D, 0xB7, 0xE7, 0x1B, 0x80, 0x8B, 0x01, 0xFD, 0x8E, 0xCC, 0xBC, 0x73, 0x7C, 0x46, 0xF3, 0x8D,
+ 0x9D, 0x76, 0xE8, 0x9A, 0x03, 0x96, 0x1C, 0x60, 0xEC, 0x19, 0xE2, 0x60, 0xC3, 0xA7, 0x38, 0x9D,
+ 0x4E, 0x5E, 0xAD, 0x12, 0xF5, 0xE0, 0xCB, 0x93, 0xD3, 0x13, 0x8C, 0x8F, 0x97, 0xFD, 0x29, 0x42,
+ 0xD7, 0x90, 0xA6, 0x17, 0x68, 0xB9, 0x63, 0xFE, 0x49, 0xA8, 0x35, 0xCD, 0x0A, 0x7F, 0x65, 0xEC,
+ 0xCE, 0x1D, 0xB7, 0xB5, 0xB7, 0x9D, 0xEE, 0xED, 0xBA, 0xE3, 0xFA, 0x7C, 0x70, 0xF1, 0xF5, 0xFC,
+ 0x7C, 0xE4, 0x4D, 0x0C, 0x01, 0x45, 0x9D, 0xCB, 0xF6, 0xD5, 0xDE, 0xD4, 0x50, 0x75, 0x6F, 0x01,
+ 0xED, 0xEB, 0xBD, 0xBF, 0xD5, 0xF8, 0xAA, 0xCD, 0x68, 0xF4, 0x5A, 0x88, 0x8F, 0xB5, 0x69, 0xC4,
+ 0x31, 0x03, 0xA9, 0xB0, 0x08, 0xC8, 0xFB, 0x88, 0x32, 0xA5, 0x49, 0x33, 0xF3, 0x9C, 0x0E, 0xEC,
+ 0xB4, 0x54, 0xFE, 0xC1, 0x11, 0x81, 0x15, 0xFC, 0xBF, 0x4B, 0x42, 0xFF, 0xBF, 0x63, 0x82, 0x86,
+ 0xE6, 0xFE, 0x57, 0x47, 0x05, 0x16, 0xE9, 0x7F, 0x73, 0x5C, 0x60, 0xD5, 0xD8, 0x85, 0xE2, 0xCD,
+ 0x28, 0x41, 0x09, 0xE3, 0x7B, 0x63, 0xA4, 0xB6, 0x45, 0xAA, 0xF3, 0x84, 0x4A, 0xF7, 0x06, 0xFC,
+ 0xA5, 0xF9, 0xF6, 0x06, 0x73, 0x29, 0xE6, 0x37, 0x58, 0xFB, 0x7E, 0x1B, 0xAB, 0x24, 0x91, 0x91,
+ 0xC2, 0xC3, 0x78, 0xB3, 0x13, 0x86, 0xF5, 0xA9, 0xDE, 0x99, 0x9A, 0x3E, 0x90, 0x30, 0x21, 0x49,
+ 0xB9, 0x8B, 0x22, 0xB4, 0xE1, 0x14, 0xE6, 0xE4, 0x3B, 0xB2, 0x86, 0xA1, 0x19, 0xBD, 0x94, 0xA3,
+ 0x83, 0xDA, 0xEE, 0x2A, 0xA0, 0xD8, 0x34, 0x35, 0xD0, 0x2F, 0xDC, 0x35, 0x69, 0xC6, 0x7D, 0xE3,
+ 0xE0, 0xF5, 0xCD, 0x8E, 0x5F, 0xF1, 0xD0, 0x4C, 0x83, 0xF7, 0x9F, 0xD4, 0x55, 0x91, 0xDF, 0x09,
+ 0x38, 0x98, 0x82, 0x6D, 0xE4, 0x73, 0x97, 0x42, 0xE7, 0x95, 0x8E, 0xDC, 0xA3, 0x5A, 0xC3, 0x22,
+ 0x4C, 0x2F, 0xC4, 0x39, 0x01, 0xD3, 0xE4, 0xDD, 0x8E, 0x1A, 0x1E, 0x47, 0x51, 0xEB, 0x4B, 0x16,
+ 0x3A, 0x51, 0xE0, 0xD7, 0xAE, 0xE6, 0xB3, 0x1B, 0x9B, 0xC8, 0xF9, 0xFC, 0xA0, 0x3A, 0x65, 0x99,
+ 0x61, 0xA4, 0x29, 0x11, 0x97, 0xAD, 0x4F, 0x51, 0x3C, 0x3C, 0xA6, 0x17, 0x81, 0xFC, 0xC1, 0x42,
+ 0x3F, 0xCE, 0x16, 0x59, 0x90, 0xA7, 0x8B, 0xD6, 0x97, 0x0B, 0x5F, 0xD7, 0x52, 0x12, 0x5F, 0x7B,
+ 0x06, 0x29, 0x67, 0x8A, 0x26, 0x62, 0x62, 0xA7, 0xDA, 0xED, 0x52, 0x85, 0x91, 0x0C, 0xBB, 0x9E,
+ 0x52, 0xB6, 0x3A, 0x5D, 0xC8, 0x5C, 0x44, 0x52, 0x5C, 0x2D, 0x65, 0x31, 0x2D, 0x32, 0x74, 0x6D,
+ 0xA6, 0xE5, 0xF8, 0x6B, 0xA8, 0xAE, 0x11, 0x97, 0x29, 0x16, 0x17, 0x4A, 0x96, 0x22, 0x5A, 0x89,
+ 0x05, 0xA3, 0x4E, 0x91, 0x86, 0xF8, 0x22, 0x46, 0x7B, 0x57, 0x28, 0x44, 0xF6, 0x5F, 0xC0, 0xFD,
+ 0xE2, 0xC5, 0x57, 0x67, 0x83, 0xC7, 0xF5, 0x8F, 0x1E, 0xC4, 0xF1, 0xD7, 0xD5, 0x57, 0x0F, 0x6B,
+ 0x7B, 0x00, 0x35, 0xCD, 0xE2, 0x08, 0xF4, 0x41, 0x65, 0x70, 0xCC, 0x54, 0xB2, 0x94, 0xE8, 0x88,
+ 0x37, 0x45, 0xB6, 0xC0, 0x98, 0x92, 0xD0, 0xBB, 0x38, 0x22, 0x2A, 0x84, 0xF9, 0x70, 0x6C, 0xFB,
+ 0x49, 0x17, 0xD3, 0xC1, 0xAC, 0x06, 0xCC, 0x5D, 0xB6, 0x9D, 0x41, 0x69, 0xBE, 0xEC, 0x62, 0x43,
+ 0x35, 0xBE, 0x7E, 0xF8, 0x0F, 0x15, 0xAB, 0x2C, 0x52, 0x0C, 0x27, 0x00, 0x00
+};
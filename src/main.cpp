@@ -12,9 +12,13 @@
 #include "WebServer.h"
 #include "esp_wifi.h"
 #include "esp_camera.h"
+#include "esp_heap_caps.h"
 #include "soc/soc.h"
 #include "soc/rtc_cntl_reg.h"
 #include <user_define.h>
+#include "frame_broadcaster.h"
+#include "clip_recorder.h"
+#include "burst_recorder.h"
 
 void rcCar_setup();
 void startCameraServer(void);
@@ -68,6 +72,19 @@ void setup() {
     config.jpeg_quality = 12;
     config.fb_count = 1;
   }
+  config.fb_location = psramFound() ? CAMERA_FB_IN_PSRAM : CAMERA_FB_IN_DRAM;
+  config.grab_mode = CAMERA_GRAB_WHEN_EMPTY;
+
+  // Low latency: always hand out the newest frame, age matters more than throughput
+  if (CAMERA_LOW_LATENCY && psramFound()){
+    config.grab_mode = CAMERA_GRAB_LATEST;
+    config.fb_count = CAMERA_FB_COUNT;
+    if (CAMERA_BUFFERS_IN_DRAM){
+      // Internal RAM only fits small buffers, the stream can't go above QVGA
+      config.fb_location = CAMERA_FB_IN_DRAM;
+      config.frame_size = FRAMESIZE_QVGA;
+    }
+  }
 
   if (enableCAM){
     // camera init
@@ -96,6 +113,14 @@ void setup() {
     }
     // drop down frame size for higher initial frame rate
     s->set_framesize(s, FRAMESIZE_QVGA);
+
+    broadcaster_start(config.frame_size); // Single capture task shared by every viewer
+    // The frame pool grows when a larger framesize is streamed, keep that much PSRAM for it
+    size_t reserve = broadcaster_pool_growth() + PSRAM_RESERVE;
+    clip_recorder_init(reserve); // Last seconds of the stream, for /clip
+    burst_recorder_init(reserve); // Arena for /burst
+    Serial.printf("PSRAM: %uB free, %uB kept for the frame pool and the heap\n",
+                  (uint32_t)heap_caps_get_free_size(MALLOC_CAP_SPIRAM), (uint32_t)reserve);
   }
 
   // Start the Access Point
@@ -0,0 +1,163 @@
+/*
+  ESP32CAM rcCar
+  Motor control task: applies the newest joystick setpoint at a fixed rate, stops the car when commands stop
+*/
+
+#include "motor_control.h"
+#include "Arduino.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <user_define.h>
+#include "frame_broadcaster.h"
+#include <drive_mixer.h>
+#include <slew_limiter.h>
+
+// MCPWM outputs, app_httpd.cpp
+void rcCar_stop();
+void rcCar_set_duty(int right, int left);
+
+// Handling of the car, see drive_mixer.h
+static constexpr drive_mixer_config_t mixer_config = DRIVE_MIXER_DEFAULT;
+DRIVE_TURN_LUT(turn_lut, mixer_config);
+
+static portMUX_TYPE motor_mux = portMUX_INITIALIZER_UNLOCKED;
+static int setpoint_x = 0;
+static int setpoint_y = 0;
+static int64_t setpoint_time = 0; // esp_timer_get_time() of the last command, 0 before the first one
+static int duty_right = 0;        // Duty cycles applied
+static int duty_left = 0;
+static slew_state_t slew_right;   // Rate limits on the duty cycles, motor task only
+static slew_state_t slew_left;
+static motor_stats_t stats;       // Under motor_mux
+static uint64_t jitter_sum = 0;
+
+static void motor_stats_reset() {
+    uint32_t deadman_stops = stats.deadman_stops;
+    memset(&stats, 0, sizeof(stats));
+    stats.period_min_us = UINT32_MAX;
+    stats.deadman_stops = deadman_stops;
+    jitter_sum = 0;
+}
+
+static void motor_task_fn(void *arg) {
+    TickType_t period = pdMS_TO_TICKS(1000 / MOTOR_CONTROL_HZ);
+    if (period == 0) {
+        period = 1; // Slower than asked with a coarse tick
+    }
+    const int64_t period_us = (int64_t)period * portTICK_PERIOD_MS * 1000;
+    TickType_t wake = xTaskGetTickCount();
+    int64_t last = esp_timer_get_time();
+
+    for (;;) {
+        vTaskDelayUntil(&wake, period);
+        int64_t now = esp_timer_get_time();
+        int64_t elapsed = now - last;
+        last = now;
+
+        portENTER_CRITICAL(&motor_mux);
+        int x = setpoint_x;
+        int y = setpoint_y;
+        int64_t commanded = setpoint_time;
+        uint32_t jitter = (uint32_t)llabs(elapsed - period_us);
+        stats.loops++;
+        stats.period_min_us = min(stats.period_min_us, (uint32_t)elapsed);
+        stats.period_max_us = max(stats.period_max_us, (uint32_t)elapsed);
+        stats.jitter_max_us = max(stats.jitter_max_us, jitter);
+        jitter_sum += jitter;
+        if (elapsed >= 2 * period_us) {
+            stats.overruns++;
+        }
+        portEXIT_CRITICAL(&motor_mux);
+
+        bool fresh = commanded && now - commanded < (int64_t)MOTOR_TIMEOUT_MS * 1000;
+        if (!fresh) {
+            // Link lost or page frozen, don't keep driving the last command.
+            // Right away, not through the brake limit
+            slew_reset(&slew_right, 0);
+            slew_reset(&slew_left, 0);
+            if (duty_right || duty_left) {
+                Serial.printf("No command for %d ms, dead-man stop\n", MOTOR_TIMEOUT_MS);
+                rcCar_stop();
+                portENTER_CRITICAL(&motor_mux);
+                duty_right = duty_left = 0;
+                stats.deadman_stops++;
+                portEXIT_CRITICAL(&motor_mux);
+            }
+            continue;
+        }
+
+        int target_right, target_left;
+        drive_mix(mixer_config, x, y, &target_right, &target_left, turn_lut);
+        // Ramp toward the target, a joystick flick must not slam the H-bridge
+        int right = slew_step(&slew_right, target_right);
+        int left = slew_step(&slew_left, target_left);
+        if (right == duty_right && left == duty_left) {
+            continue;
+        }
+        if (right == 0 && left == 0) {
+            rcCar_stop();
+        } else {
+            if (DEBUG) {
+                Serial.printf("Duty Cycle Right: %d, Left: %d\n", right, left);
+            }
+            rcCar_set_duty(right, left);
+        }
+        portENTER_CRITICAL(&motor_mux);
+        duty_right = right;
+        duty_left = left;
+        portEXIT_CRITICAL(&motor_mux);
+    }
+}
+
+void motor_control_start() {
+    slew_limits_t limits = { MOTOR_ACCEL, MOTOR_BRAKE, MOTOR_REVERSE };
+    slew_init(&slew_right, &limits, MOTOR_CONTROL_HZ);
+    slew_init(&slew_left, &limits, MOTOR_CONTROL_HZ);
+    motor_stats_reset();
+    // Above the capture and network tasks, on the core away from Wi-Fi
+    if (xTaskCreatePinnedToCore(motor_task_fn, "motor", 3072, NULL, MOTOR_TASK_PRIORITY, NULL, CAMERA_TASK_CORE) != pdPASS) {
+        Serial.println("Motor control task creation failed");
+        return;
+    }
+    Serial.printf("Motor control at %d Hz, dead-man after %d ms\n", MOTOR_CONTROL_HZ, MOTOR_TIMEOUT_MS);
+}
+
+void motor_set(int x, int y) {
+    x = max(-100, min(100, x));
+    y = max(-100, min(100, y));
+    portENTER_CRITICAL(&motor_mux);
+    setpoint_x = x;
+    setpoint_y = y;
+    setpoint_time = esp_timer_get_time();
+    portEXIT_CRITICAL(&motor_mux);
+
+    if (abs(x) >= mixer_config.deadband || abs(y) >= mixer_config.deadband) {
+        // Motion commanded, the stream must not stay throttled
+        broadcaster_rearm();
+    }
+}
+
+void motor_state(int *x, int *y, int32_t *age_ms, int *right, int *left) {
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&motor_mux);
+    *x = setpoint_x;
+    *y = setpoint_y;
+    *age_ms = setpoint_time ? (int32_t)((now - setpoint_time) / 1000) : -1;
+    *right = duty_right;
+    *left = duty_left;
+    portEXIT_CRITICAL(&motor_mux);
+}
+
+void motor_stats(motor_stats_t *out, bool reset) {
+    portENTER_CRITICAL(&motor_mux);
+    *out = stats;
+    out->jitter_avg_us = stats.loops ? (uint32_t)(jitter_sum / stats.loops) : 0;
+    if (!stats.loops) {
+        out->period_min_us = 0;
+    }
+    if (reset) {
+        motor_stats_reset();
+    }
+    portEXIT_CRITICAL(&motor_mux);
+}
@@ -0,0 +1,33 @@
+#ifndef MOTOR_CONTROL_H
+#define MOTOR_CONTROL_H
+
+#include <stdint.h>
+
+// Motor control task: the network handlers only set the joystick setpoint,
+// the task mixes it into the duty cycles at MOTOR_CONTROL_HZ and stops the
+// motors when no command came within MOTOR_TIMEOUT_MS (dead-man).
+
+typedef struct {
+    uint32_t loops;         // Iterations in the window
+    uint32_t period_min_us; // Measured loop period
+    uint32_t period_max_us;
+    uint32_t jitter_avg_us; // Mean |period - nominal period|
+    uint32_t jitter_max_us;
+    uint32_t overruns;      // Periods of twice the nominal period or more
+    uint32_t deadman_stops; // Motors stopped by the timeout, since boot
+} motor_stats_t;
+
+// Start the task, the MCPWM outputs must be initialised
+void motor_control_start();
+
+// New joystick setpoint, x and y in -100..100. Also feeds the dead-man timer.
+void motor_set(int x, int y);
+
+// Current setpoint, age of the last command in ms (-1 before the first one)
+// and duty cycles applied
+void motor_state(int *x, int *y, int32_t *age_ms, int *duty_right, int *duty_left);
+
+// Loop statistics since the previous call with reset
+void motor_stats(motor_stats_t *out, bool reset);
+
+#endif // MOTOR_CONTROL_H
@@ -0,0 +1,96 @@
+/*
+  ESP32CAM rcCar
+  Reduced scale preview stream
+*/
+
+#include "stream_preview.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "img_converters.h"
+#include "freertos/semphr.h"
+#include "Arduino.h"
+
+// esp_jpg_decode works in a static buffer, the preview senders take turns
+static SemaphoreHandle_t decode_mutex = NULL;
+
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t len;
+} preview_writer_t;
+
+static size_t preview_write(void *arg, size_t index, const void *data, size_t len){
+    preview_writer_t *writer = (preview_writer_t *)arg;
+    if (index + len > writer->size){
+        return 0; // Stops the encoder
+    }
+    memcpy(writer->buf + index, data, len);
+    writer->len = index + len;
+    return len;
+}
+
+void preview_init(){
+    if (!decode_mutex){
+        decode_mutex = xSemaphoreCreateMutex();
+    }
+}
+
+int preview_parse_scale(const char *str){
+    if (!strncmp(str, "1/", 2)){
+        str += 2;
+    }
+    int scale = atoi(str);
+    return (scale == 2 || scale == 4 || scale == 8) ? scale : 0;
+}
+
+static bool preview_reserve(uint8_t **buf, size_t *size, size_t needed){
+    if (*size >= needed){
+        return true;
+    }
+    free(*buf);
+    *buf = (uint8_t *)heap_caps_malloc(needed, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    *size = *buf ? needed : 0;
+    return *buf != NULL;
+}
+
+bool preview_encode(stream_preview_t *preview, const shared_frame_t *frame, int quality){
+    int shift = preview->scale == 8 ? 3 : (preview->scale == 4 ? 2 : 1);
+    jpg_scale_t jpg_scale = shift == 3 ? JPG_SCALE_8X : (shift == 2 ? JPG_SCALE_4X : JPG_SCALE_2X);
+    uint16_t width = frame->width >> shift;
+    uint16_t height = frame->height >> shift;
+    // The decoder writes whole blocks, leave room for the partial ones on the edges
+    size_t rgb_len = (size_t)((frame->width + 15) >> shift) * ((frame->height + 15) >> shift) * 2;
+    if (!preview_reserve(&preview->rgb, &preview->rgb_size, rgb_len) ||
+        !preview_reserve(&preview->jpg, &preview->jpg_size, rgb_len / 2)){
+        Serial.println("Preview buffer allocation failed");
+        return false;
+    }
+
+    xSemaphoreTake(decode_mutex, portMAX_DELAY);
+    int64_t start = esp_timer_get_time();
+    bool decoded_ok = jpg2rgb565(frame->buf, frame->len, preview->rgb, jpg_scale);
+    int64_t decoded = esp_timer_get_time();
+    xSemaphoreGive(decode_mutex);
+    if (!decoded_ok){
+        return false;
+    }
+    preview_writer_t writer = {preview->jpg, preview->jpg_size, 0};
+    if (!fmt2jpg_cb(preview->rgb, width * height * 2, width, height, PIXFORMAT_RGB565, quality, preview_write, &writer)){
+        return false;
+    }
+    preview->len = writer.len;
+    preview->width = width;
+    preview->height = height;
+    preview->decode_us = decoded - start;
+    preview->encode_us = esp_timer_get_time() - decoded;
+    return true;
+}
+
+void preview_release(stream_preview_t *preview){
+    free(preview->rgb);
+    free(preview->jpg);
+    preview->rgb = NULL;
+    preview->jpg = NULL;
+    preview->rgb_size = 0;
+    preview->jpg_size = 0;
+}
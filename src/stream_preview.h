@@ -0,0 +1,33 @@
+#ifndef STREAM_PREVIEW_H
+#define STREAM_PREVIEW_H
+
+#include "frame_broadcaster.h"
+
+// Downscaled copy of the stream for spectators: the frame is decoded at 1/2, 1/4
+// or 1/8 scale and encoded again, into buffers kept for the whole connection
+typedef struct {
+    int scale;           // 2, 4 or 8
+    uint8_t *rgb;        // RGB565 at the reduced scale
+    size_t rgb_size;
+    uint8_t *jpg;        // Encoded preview
+    size_t jpg_size;
+    size_t len;
+    uint16_t width;
+    uint16_t height;
+    uint32_t decode_us;  // Cost of the last frame
+    uint32_t encode_us;
+} stream_preview_t;
+
+// Create the decoder lock, before the first preview_encode()
+void preview_init();
+
+// Scale from "1/2", "1/4", "1/8" (or 2, 4, 8), 0 if invalid
+int preview_parse_scale(const char *str);
+
+// Make the preview of a frame, the buffers grow with the frame size.
+// Decodes are serialised, the encodes run in parallel
+bool preview_encode(stream_preview_t *preview, const shared_frame_t *frame, int quality);
+
+void preview_release(stream_preview_t *preview);
+
+#endif // STREAM_PREVIEW_H
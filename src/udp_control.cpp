@@ -0,0 +1,100 @@
+/*
+  ESP32CAM rcCar
+  UDP command port: fixed size joystick packets, a telemetry reply for each accepted one
+*/
+
+#include "udp_control.h"
+#include "control_protocol.h"
+#include "Arduino.h"
+#include "esp_timer.h"
+#include "lwip/sockets.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <user_define.h>
+#include "motor_control.h"
+#include <udp_link.h>
+
+// State reported in the telemetry, app_httpd.cpp
+extern int batteryPercentage;
+extern volatile float camera_fps;
+
+static int udp_sock = -1;
+
+static void udp_control_task(void *arg) {
+    udp_link_t link;
+    udp_link_init(&link, UDP_MAX_AGE_MS);
+
+    for (;;) {
+        udp_cmd_t cmd;
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        int len = recvfrom(udp_sock, &cmd, sizeof(cmd), 0, (struct sockaddr *)&from, &from_len);
+        if (len < 0) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+        uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+        udp_link_verdict_t verdict = udp_link_check(&link, &cmd, len, from.sin_addr.s_addr, from.sin_port, now_ms);
+        if (verdict != UDP_LINK_ACCEPT && verdict != UDP_LINK_NEW_PEER) {
+            continue;
+        }
+        if (verdict == UDP_LINK_NEW_PEER) {
+            char addr[16];
+            inet_ntoa_r(from.sin_addr, addr, sizeof(addr));
+            Serial.printf("UDP control from %s:%u\n", addr, ntohs(from.sin_port));
+        }
+
+        if (cmd.flags & UDP_FLAG_STOP) {
+            motor_set(0, 0);
+        } else {
+            motor_set(cmd.x, cmd.y);
+        }
+
+        // Duty cycles of the previous command, the motor task applies this one on its next tick
+        int x, y, duty_right, duty_left;
+        int32_t age_ms;
+        motor_state(&x, &y, &age_ms, &duty_right, &duty_left);
+        udp_telemetry_t reply;
+        memset(&reply, 0, sizeof(reply));
+        reply.magic = UDP_TELEMETRY_MAGIC;
+        reply.battery = (uint8_t)batteryPercentage;
+        reply.flags = cmd.flags;
+        reply.seq = cmd.seq;
+        reply.client_ms = cmd.client_ms;
+        reply.device_ms = (uint32_t)(esp_timer_get_time() / 1000);
+        reply.duty_right = (int8_t)duty_right;
+        reply.duty_left = (int8_t)duty_left;
+        reply.fps_x10 = (uint16_t)(camera_fps * 10);
+        reply.dropped = link.dropped;
+        sendto(udp_sock, &reply, sizeof(reply), 0, (struct sockaddr *)&from, from_len);
+    }
+}
+
+bool udp_control_start(uint16_t port) {
+    udp_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    if (udp_sock < 0) {
+        Serial.println("UDP control: socket failed");
+        return false;
+    }
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(udp_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        Serial.printf("UDP control: bind to port %u failed\n", port);
+        close(udp_sock);
+        udp_sock = -1;
+        return false;
+    }
+
+    // Above the stream senders, a command must not wait behind a frame
+    if (xTaskCreatePinnedToCore(udp_control_task, "udp_ctrl", 4096, NULL, 6, NULL, tskNO_AFFINITY) != pdPASS) {
+        Serial.println("UDP control: task creation failed");
+        close(udp_sock);
+        udp_sock = -1;
+        return false;
+    }
+    Serial.printf("Starting UDP control on port: '%u'\n", port);
+    return true;
+}
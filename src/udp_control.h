@@ -0,0 +1,13 @@
+#ifndef UDP_CONTROL_H
+#define UDP_CONTROL_H
+
+#include <stdint.h>
+
+// UDP command port for scripted driving, see control_protocol.h.
+// Commands from the newest sender drive the motors, each accepted command
+// gets a telemetry reply.
+
+// Open the socket and start the receive task
+bool udp_control_start(uint16_t port);
+
+#endif // UDP_CONTROL_H
@@ -41,6 +41,60 @@
 // button pin
 #define BUTTON_PIN 0
 
+// Camera
+#define CAMERA_LOW_LATENCY 1     // Grab the latest frame from a capture task pinned away from Wi-Fi
+#define CAMERA_FB_COUNT 2        // Frame buffers in low latency mode (2 or 3)
+#define CAMERA_BUFFERS_IN_DRAM 0 // Low latency mode: QVGA buffers in internal RAM instead of PSRAM
+#define CAMERA_TASK_CORE 1       // Wi-Fi runs on core 0
+#define RAW_JPEG_QUALITY 80      // Raw pixel formats: JPEG quality of the stream and /capture (/control?var=raw_quality)
+#define RAW_SKIP_UNCHANGED 0     // Raw pixel formats: reuse the previous JPEG when no tile changed
+#define RAW_TILE 16              // Tile side in pixels, two JPEG MCUs
+#define RAW_SAMPLE_STEP 4        // Every 4th pixel of every 4th row is compared
+#define RAW_CHANGE_THRESHOLD 6   // Mean absolute byte change for a tile to count as changed, above sensor noise
+
+// Stream
+#define MAX_STREAM_CLIENTS 4 // Maximum number of simultaneous viewers on :81/stream
+#define STREAM_RAW_WRITE 1   // 1: one raw write per frame, 0: HTTP chunked encoding (/control?var=stream_raw)
+#define MAX_PREVIEW_CLIENTS 2 // Viewers of /stream?scale=1/2|1/4|1/8, each costs a decode and an encode per frame
+#define PREVIEW_JPEG_QUALITY 60 // JPEG quality of the preview streams (1-100)
+#define ABR_TARGET_FPS 15    // Frame rate held by the adaptive bitrate controller, 0 to disable (/control?var=target_fps)
+#define ABR_MAX_FRAME_BYTES 30000 // Byte budget per frame held by the controller, 0 for none (/control?var=max_frame_bytes)
+#define SCENE_SUPPRESS 1     // Throttle the stream while the scene does not change
+#define SCENE_KEEPALIVE_MS 1000 // Frame interval while the scene is idle
+#define CAPTURE_MAX_AGE_MS 200  // /capture reuses the stream's frame up to this age (?max_age_ms=)
+#define CAPTURE_WAIT_MS 150     // /capture waits this long for a fresh frame, then answers 503
+
+// Control
+#define MOTOR_CONTROL_HZ 200   // Rate of the motor control task
+#define MOTOR_TIMEOUT_MS 500   // Dead-man: motors stop when no command came for this long
+#define MOTOR_TASK_PRIORITY 10 // Above the capture and stream tasks
+#define MOTOR_ACCEL 500        // Duty %/s when speeding up, 0 for no limit
+#define MOTOR_BRAKE 1000       // Duty %/s when slowing down
+#define MOTOR_REVERSE 400      // Duty %/s down to 0 before a change of direction
+#define UDP_CONTROL_PORT 4210 // UDP command port, see include/control_protocol.h
+#define UDP_MAX_AGE_MS 200    // Synced UDP commands older than this are dropped
+
+// Web server
+#define STATIC_CHUNK_SIZE 4096 // Static files are streamed in pieces of this size
+
+// Photo mode (/capture?size=uxga)
+#define PHOTO_SETTLE_FRAMES 2 // Frames dropped after a framesize switch while the exposure adapts
+#define PHOTO_TIMEOUT_MS 3000 // Upper bound for the switch, settle and grab
+
+// PSRAM budget: the frame pool's growth plus this is kept free of the clip and burst buffers
+#define PSRAM_RESERVE (256 * 1024)         // Heap allocations after setup (raw frame samples, sockets)
+
+// Clip recorder
+#define CLIP_SECONDS 10                    // Seconds kept for /clip
+#define CLIP_BUFFER_SIZE (2 * 1024 * 1024) // PSRAM ring buffer for the clip
+#define CLIP_MAX_FRAMES 512                // Frames indexed in the ring
+
+// Burst capture (/burst?n=&interval_ms=)
+#define BURST_BUFFER_SIZE (1 * 1024 * 1024) // PSRAM arena for one burst
+#define BURST_MAX_FRAMES 120                // Frames per burst
+#define BURST_MAX_INTERVAL_MS 1000          // Largest interval_ms accepted
+#define BURST_MAX_DURATION_MS 10000         // n is cut so n * interval_ms stays below this
+
 // DEBUG
 #define DEBUG 0
 #define enableCAM 1
@@ -0,0 +1,159 @@
+/*
+  ESP32CAM rcCar
+  Bitrate controller: the quality ladder, the send time and byte budget
+  loads, and the hysteresis, with the stream's settings (app_httpd.cpp).
+*/
+
+#include <unity.h>
+#include <bitrate_controller.h>
+
+// esp32-camera's framesize_t
+#define QQVGA 1
+#define HQVGA 3
+#define QVGA 5
+#define CIF 6
+#define VGA 8
+#define SVGA 9
+
+static const abr_config_t config = {
+    .target_fps = 15,
+    .max_frame_bytes = 30000,
+    .min_quality = 10,
+    .max_quality = 40,
+    .quality_step = 5,
+    .framesizes = {VGA, CIF, QVGA, HQVGA, QQVGA},
+    .framesize_count = 5,
+    .degrade_load = 0.9f,
+    .improve_load = 0.5f,
+    .degrade_windows = 1,
+    .improve_windows = 3,
+};
+
+#define WINDOW_US 1000000
+
+static abr_state_t state;
+static abr_window_t window;
+
+// One window of 15 frames of len bytes, each taking send_ms to go out
+static abr_vote_t window_of(size_t len, uint32_t send_ms){
+    for (int i = 0; i < 15; i++){
+        abr_sample(&window, len, send_ms * 1000);
+    }
+    return abr_evaluate(&config, &window, WINDOW_US);
+}
+
+void setUp(void){
+    abr_reset(&config, &state, VGA, 10);
+    window = abr_window_t();
+}
+
+void tearDown(void){}
+
+// Every quality of a framesize, worst last, then the next framesize
+static void test_ladder(void){
+    TEST_ASSERT_EQUAL_INT(VGA, abr_framesize(&config, &state));
+    TEST_ASSERT_EQUAL_INT(10, abr_quality(&config, &state));
+    for (int quality = 15; quality <= 40; quality += 5){
+        TEST_ASSERT_TRUE(abr_step(&config, &state, ABR_DEGRADE));
+        TEST_ASSERT_EQUAL_INT(VGA, abr_framesize(&config, &state));
+        TEST_ASSERT_EQUAL_INT(quality, abr_quality(&config, &state));
+    }
+    TEST_ASSERT_TRUE(abr_step(&config, &state, ABR_DEGRADE));
+    TEST_ASSERT_EQUAL_INT(CIF, abr_framesize(&config, &state));
+    TEST_ASSERT_EQUAL_INT(10, abr_quality(&config, &state));
+
+    // Bottom of the ladder
+    while (abr_step(&config, &state, ABR_DEGRADE)){}
+    TEST_ASSERT_EQUAL_INT(QQVGA, abr_framesize(&config, &state));
+    TEST_ASSERT_EQUAL_INT(40, abr_quality(&config, &state));
+}
+
+// The user's framesize and quality anchor the ladder, it never goes above them
+static void test_reset(void){
+    abr_reset(&config, &state, QVGA, 22);
+    TEST_ASSERT_EQUAL_INT(QVGA, abr_framesize(&config, &state));
+    TEST_ASSERT_EQUAL_INT(20, abr_quality(&config, &state));
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_TRUE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_TRUE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_EQUAL_INT(QVGA, abr_framesize(&config, &state));
+    TEST_ASSERT_EQUAL_INT(10, abr_quality(&config, &state));
+    for (int i = 0; i < 6; i++){
+        TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    }
+
+    // Larger than the ladder: its largest framesize. Quality clamped into the range
+    abr_reset(&config, &state, SVGA, 63);
+    TEST_ASSERT_EQUAL_INT(VGA, abr_framesize(&config, &state));
+    TEST_ASSERT_EQUAL_INT(40, abr_quality(&config, &state));
+}
+
+// Load is the share of the frame interval (66.7 ms at 15 fps) spent sending
+static void test_send_time_load(void){
+    TEST_ASSERT_EQUAL_INT(ABR_DEGRADE, window_of(10000, 70));
+    TEST_ASSERT_EQUAL_INT(ABR_HOLD, window_of(10000, 50));
+    TEST_ASSERT_EQUAL_INT(ABR_IMPROVE, window_of(10000, 20));
+}
+
+// A fast link still degrades when frames are over the byte budget
+static void test_byte_budget(void){
+    TEST_ASSERT_EQUAL_INT(ABR_DEGRADE, window_of(40000, 5));
+    TEST_ASSERT_EQUAL_INT(ABR_HOLD, window_of(20000, 5));
+    TEST_ASSERT_EQUAL_INT(ABR_IMPROVE, window_of(10000, 5));
+
+    abr_config_t no_budget = config;
+    no_budget.max_frame_bytes = 0;
+    for (int i = 0; i < 15; i++){
+        abr_sample(&window, 40000, 5000);
+    }
+    TEST_ASSERT_EQUAL_INT(ABR_IMPROVE, abr_evaluate(&no_budget, &window, WINDOW_US));
+}
+
+// No frames in a window is no evidence either way, and the window restarts
+static void test_empty_window(void){
+    TEST_ASSERT_EQUAL_INT(ABR_HOLD, abr_evaluate(&config, &window, WINDOW_US));
+    window_of(10000, 70);
+    TEST_ASSERT_EQUAL_INT(0, (int)window.frames);
+    TEST_ASSERT_EQUAL_INT(0, (int)window.bytes);
+    TEST_ASSERT_EQUAL_INT(0, (int)window.send_us);
+
+    abr_config_t disabled = config;
+    disabled.target_fps = 0;
+    for (int i = 0; i < 15; i++){
+        abr_sample(&window, 40000, 70000);
+    }
+    TEST_ASSERT_EQUAL_INT(ABR_HOLD, abr_evaluate(&disabled, &window, WINDOW_US));
+}
+
+// Stepping up takes improve_windows good windows in a row, any other vote starts over
+static void test_hysteresis(void){
+    TEST_ASSERT_TRUE(abr_step(&config, &state, ABR_DEGRADE));
+    TEST_ASSERT_TRUE(abr_step(&config, &state, ABR_DEGRADE));
+    TEST_ASSERT_EQUAL_INT(20, abr_quality(&config, &state));
+
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_HOLD));
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_TRUE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_EQUAL_INT(15, abr_quality(&config, &state));
+
+    TEST_ASSERT_FALSE(abr_step(&config, &state, ABR_IMPROVE));
+    TEST_ASSERT_TRUE(abr_step(&config, &state, ABR_DEGRADE)); // One bad window is enough
+    TEST_ASSERT_EQUAL_INT(20, abr_quality(&config, &state));
+}
+
+int main(int argc, char **argv){
+    UNITY_BEGIN();
+    RUN_TEST(test_ladder);
+    RUN_TEST(test_reset);
+    RUN_TEST(test_send_time_load);
+    RUN_TEST(test_byte_budget);
+    RUN_TEST(test_empty_window);
+    RUN_TEST(test_hysteresis);
+    return UNITY_END();
+}
@@ -0,0 +1,133 @@
+/*
+  ESP32CAM rcCar
+  Fixed-point drive mixer against the float mixer it replaced, over every
+  stick position, plus the cost of one mix on the host.
+*/
+
+#include <unity.h>
+#include <drive_mixer.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+
+static constexpr drive_mixer_config_t config = DRIVE_MIXER_DEFAULT;
+DRIVE_TURN_LUT(turn_lut, config);
+
+// The mixer of the original joystick handler, as it was
+static void float_mix(int x, int y, int *right, int *left){
+    if (abs(x) < 10 && abs(y) < 10){
+        *right = 0;
+        *left = 0;
+        return;
+    }
+    float turn_factor = 1.0f - pow(abs(x) / 100.0f, 2.0f);
+    turn_factor = fmaxf(0.9f, fminf(1.0f, turn_factor));
+    int adjusted_x = (y < -10) ? -x : x;
+    float weight = 0.5f;
+    int duty_cycle_right = y - (adjusted_x * weight);
+    int duty_cycle_left = y + (adjusted_x * weight);
+    duty_cycle_right *= turn_factor;
+    duty_cycle_left *= turn_factor;
+    *right = duty_cycle_right < -100 ? -100 : (duty_cycle_right > 100 ? 100 : duty_cycle_right);
+    *left = duty_cycle_left < -100 ? -100 : (duty_cycle_left > 100 ? 100 : duty_cycle_left);
+}
+
+void setUp(void){}
+
+void tearDown(void){}
+
+static void test_matches_float_mixer(void){
+    char message[96];
+    for (int x = -DRIVE_AXIS_MAX; x <= DRIVE_AXIS_MAX; x++){
+        for (int y = -DRIVE_AXIS_MAX; y <= DRIVE_AXIS_MAX; y++){
+            int expected_right, expected_left, right, left;
+            float_mix(x, y, &expected_right, &expected_left);
+            drive_mix(config, x, y, &right, &left);
+            snprintf(message, sizeof(message), "x %d y %d: float %d %d, fixed %d %d",
+                     x, y, expected_right, expected_left, right, left);
+            TEST_ASSERT_EQUAL_INT_MESSAGE(expected_right, right, message);
+            TEST_ASSERT_EQUAL_INT_MESSAGE(expected_left, left, message);
+        }
+    }
+}
+
+static void test_lut_matches_formula(void){
+    for (int ax = 0; ax <= DRIVE_AXIS_MAX; ax++){
+        TEST_ASSERT_EQUAL_INT(drive_turn_factor(config, ax), turn_lut[ax]);
+    }
+    for (int x = -DRIVE_AXIS_MAX; x <= DRIVE_AXIS_MAX; x++){
+        for (int y = -DRIVE_AXIS_MAX; y <= DRIVE_AXIS_MAX; y++){
+            int right, left, lut_right, lut_left;
+            drive_mix(config, x, y, &right, &left);
+            drive_mix(config, x, y, &lut_right, &lut_left, turn_lut);
+            TEST_ASSERT_EQUAL_INT(right, lut_right);
+            TEST_ASSERT_EQUAL_INT(left, lut_left);
+        }
+    }
+}
+
+// Out of range input is clamped like the motor task's setpoints
+static void test_clamped(void){
+    int right, left;
+    drive_mix(config, 0, 500, &right, &left);
+    TEST_ASSERT_EQUAL_INT(100, right);
+    TEST_ASSERT_EQUAL_INT(100, left);
+    drive_mix(config, -500, -500, &right, &left);
+    int expected_right, expected_left;
+    float_mix(-100, -100, &expected_right, &expected_left);
+    TEST_ASSERT_EQUAL_INT(expected_right, right);
+    TEST_ASSERT_EQUAL_INT(expected_left, left);
+}
+
+// Nanoseconds per mix over every stick position, repeated. For information only,
+// the host is no stand-in for the S3, where pow() is double precision in software.
+typedef void (*mix_fn_t)(int x, int y, int *right, int *left);
+
+static void fixed_mix(int x, int y, int *right, int *left){
+    drive_mix(config, x, y, right, left);
+}
+
+static void lut_mix(int x, int y, int *right, int *left){
+    drive_mix(config, x, y, right, left, turn_lut);
+}
+
+static volatile int sink;
+
+static double time_mix(mix_fn_t mix){
+    const int rounds = 50;
+    auto start = std::chrono::steady_clock::now();
+    int sum = 0;
+    for (int r = 0; r < rounds; r++){
+        for (int x = -DRIVE_AXIS_MAX; x <= DRIVE_AXIS_MAX; x++){
+            for (int y = -DRIVE_AXIS_MAX; y <= DRIVE_AXIS_MAX; y++){
+                int right, left;
+                mix(x, y, &right, &left);
+                sum += right - left;
+            }
+        }
+    }
+    sink = sum;
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / (rounds * 201.0 * 201.0);
+}
+
+static void test_timing(void){
+    char message[96];
+    double float_ns = time_mix(float_mix);
+    double fixed_ns = time_mix(fixed_mix);
+    double lut_ns = time_mix(lut_mix);
+    snprintf(message, sizeof(message), "ns per mix: float %.1f, fixed %.1f, fixed with LUT %.1f",
+             float_ns, fixed_ns, lut_ns);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char **argv){
+    UNITY_BEGIN();
+    RUN_TEST(test_matches_float_mixer);
+    RUN_TEST(test_lut_matches_formula);
+    RUN_TEST(test_clamped);
+    RUN_TEST(test_timing);
+    return UNITY_END();
+}
@@ -0,0 +1,93 @@
+/*
+  ESP32CAM rcCar
+  On the car: DC-only thumbnail against esp_jpg_decode's 1/8 scale (jpg2rgb565),
+  the decoder the scene detector would otherwise use. pio test -e esp32-s3-devkitc-1-n8r8
+*/
+
+#include <Arduino.h>
+#include <unity.h>
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "img_converters.h"
+#include <jpeg_dc.h>
+
+#define WIDTH 320 // QVGA, the stream's size
+#define HEIGHT 240
+#define RUNS 50
+
+static uint8_t *jpg = NULL;
+static size_t jpg_len = 0;
+static jpeg_dc_decoder_t decoder;
+static uint8_t thumbnail[(WIDTH / 8) * (HEIGHT / 8)];
+static uint8_t rgb565[(WIDTH / 8) * (HEIGHT / 8) * 2];
+
+// A camera-like QVGA frame: gradients plus noise, encoded by esp32-camera
+static void make_frame(int quality){
+    free(jpg);
+    jpg = NULL;
+    uint16_t *pixels = (uint16_t *)heap_caps_malloc(WIDTH * HEIGHT * 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(pixels);
+    for (int y = 0; y < HEIGHT; y++){
+        for (int x = 0; x < WIDTH; x++){
+            uint8_t r = (x + esp_random() % 16) & 0xFF;
+            uint8_t g = (y + esp_random() % 16) & 0xFF;
+            uint8_t b = ((x + y) / 2) & 0xFF;
+            uint16_t v = (r & 0xF8) << 8 | (g & 0xFC) << 3 | b >> 3;
+            pixels[y * WIDTH + x] = v >> 8 | v << 8; // Big endian, as the sensor sends it
+        }
+    }
+    TEST_ASSERT_TRUE(fmt2jpg((uint8_t *)pixels, WIDTH * HEIGHT * 2, WIDTH, HEIGHT, PIXFORMAT_RGB565, quality, &jpg, &jpg_len));
+    free(pixels);
+}
+
+static void bench(int quality){
+    make_frame(quality);
+    int width, height;
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < RUNS; i++){
+        TEST_ASSERT_TRUE(jpeg_dc_thumbnail(&decoder, jpg, jpg_len, thumbnail, sizeof(thumbnail), &width, &height));
+    }
+    int64_t dc_us = (esp_timer_get_time() - start) / RUNS;
+
+    start = esp_timer_get_time();
+    for (int i = 0; i < RUNS; i++){
+        TEST_ASSERT_TRUE(jpg2rgb565(jpg, jpg_len, rgb565, JPG_SCALE_8X));
+    }
+    int64_t decode_us = (esp_timer_get_time() - start) / RUNS;
+
+    TEST_ASSERT_EQUAL_INT(WIDTH / 8, width);
+    TEST_ASSERT_EQUAL_INT(HEIGHT / 8, height);
+    char message[96];
+    snprintf(message, sizeof(message), "q%d, %uB: jpeg_dc %lld us, esp_jpg_decode 1/8 %lld us (x%.1f)",
+             quality, (unsigned)jpg_len, dc_us, decode_us, dc_us ? (float)decode_us / dc_us : 0.0f);
+    TEST_MESSAGE(message);
+}
+
+void setUp(void){}
+
+void tearDown(void){}
+
+// Encoder quality 1..100, fine to coarse
+static void test_bench_q90(void){
+    bench(90);
+}
+
+static void test_bench_q75(void){
+    bench(75);
+}
+
+static void test_bench_q50(void){
+    bench(50);
+}
+
+void setup(){
+    delay(2000); // Serial over USB CDC
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_q90);
+    RUN_TEST(test_bench_q75);
+    RUN_TEST(test_bench_q50);
+    UNITY_END();
+}
+
+void loop(){}
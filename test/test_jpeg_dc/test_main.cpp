@@ -0,0 +1,262 @@
+/*
+  ESP32CAM rcCar
+  DC-only decoder against libjpeg's 1/8 scaled decode, and corrupted input.
+  Needs libjpeg on the host (libjpeg-turbo8-dev or libjpeg-dev).
+*/
+
+#include <unity.h>
+#include <jpeg_dc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <jpeglib.h>
+
+#define OUT_SIZE (200 * 150) // 1/8 of UXGA
+
+static jpeg_dc_decoder_t decoder;
+static uint8_t out[OUT_SIZE];
+static uint8_t expected[OUT_SIZE];
+
+typedef struct {
+    int width;
+    int height;
+    int components;     // 1 grayscale, 3 YCbCr
+    int h_samp;         // Luma sampling factors, 2x2 is 4:2:0
+    int v_samp;
+    int quality;
+    int restart_rows;   // Restart interval in MCU rows, 0 for none
+    bool progressive;
+    bool tables;        // False for an abbreviated frame without DHT/DQT
+} encode_options_t;
+
+static const encode_options_t QVGA_420 = { 320, 240, 3, 2, 2, 75, 0, false, true };
+
+// Gradients plus noise, every block gets a different mean
+static void test_image(int width, int height, int components, unsigned seed, uint8_t *pixels){
+    srand(seed);
+    for (int y = 0; y < height; y++){
+        for (int x = 0; x < width; x++){
+            for (int c = 0; c < components; c++){
+                int v = (x * (c + 1) + y * (3 - c)) % 256 + rand() % 32 - 16;
+                pixels[(y * width + x) * components + c] = (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+            }
+        }
+    }
+}
+
+// Encode with libjpeg, the caller frees *jpg
+static void encode(const encode_options_t &options, unsigned seed, uint8_t **jpg, unsigned long *len){
+    uint8_t *pixels = (uint8_t *)malloc(options.width * options.height * options.components);
+    test_image(options.width, options.height, options.components, seed, pixels);
+
+    jpeg_compress_struct cinfo;
+    jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    *jpg = NULL;
+    *len = 0;
+    jpeg_mem_dest(&cinfo, jpg, len);
+    cinfo.image_width = options.width;
+    cinfo.image_height = options.height;
+    cinfo.input_components = options.components;
+    cinfo.in_color_space = options.components == 1 ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, options.quality, TRUE);
+    cinfo.comp_info[0].h_samp_factor = options.h_samp;
+    cinfo.comp_info[0].v_samp_factor = options.v_samp;
+    cinfo.restart_in_rows = options.restart_rows;
+    if (options.progressive){
+        jpeg_simple_progression(&cinfo);
+    }
+    if (!options.tables){
+        jpeg_suppress_tables(&cinfo, TRUE);
+    }
+    jpeg_start_compress(&cinfo, options.tables);
+    while (cinfo.next_scanline < cinfo.image_height){
+        JSAMPROW row = pixels + cinfo.next_scanline * options.width * options.components;
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    free(pixels);
+}
+
+// libjpeg's 1/8 scaled luma, the 1x1 IDCT of every block
+static void decode_eighth(const uint8_t *jpg, unsigned long len, int *width, int *height){
+    jpeg_decompress_struct cinfo;
+    jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, (unsigned char *)jpg, len);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = 8;
+    cinfo.out_color_space = JCS_GRAYSCALE;
+    cinfo.do_fancy_upsampling = FALSE;
+    jpeg_start_decompress(&cinfo);
+    *width = cinfo.output_width;
+    *height = cinfo.output_height;
+    while (cinfo.output_scanline < cinfo.output_height){
+        JSAMPROW row = expected + cinfo.output_scanline * cinfo.output_width;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+}
+
+static void check_against_libjpeg(const encode_options_t &options){
+    uint8_t *jpg;
+    unsigned long len;
+    encode(options, options.width + options.quality, &jpg, &len);
+    int width, height, expected_width, expected_height;
+    TEST_ASSERT_TRUE(jpeg_dc_thumbnail(&decoder, jpg, len, out, sizeof(out), &width, &height));
+    decode_eighth(jpg, len, &expected_width, &expected_height);
+    free(jpg);
+    TEST_ASSERT_EQUAL_INT(expected_width, width);
+    TEST_ASSERT_EQUAL_INT(expected_height, height);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, width * height);
+}
+
+void setUp(void){
+    memset(&decoder, 0, sizeof(decoder));
+}
+
+void tearDown(void){}
+
+static void test_subsampling(void){
+    encode_options_t options = QVGA_420;
+    check_against_libjpeg(options); // 4:2:0, the OV2640's
+    options.v_samp = 1;
+    check_against_libjpeg(options); // 4:2:2
+    options.h_samp = 1;
+    check_against_libjpeg(options); // 4:4:4
+}
+
+static void test_grayscale(void){
+    encode_options_t options = QVGA_420;
+    options.components = 1;
+    options.h_samp = options.v_samp = 1;
+    check_against_libjpeg(options);
+}
+
+static void test_odd_sizes(void){
+    encode_options_t options = QVGA_420;
+    const int sizes[][2] = { { 100, 75 }, { 33, 17 }, { 8, 8 }, { 1, 1 }, { 1600, 1200 } };
+    for (const auto &size : sizes){
+        options.width = size[0];
+        options.height = size[1];
+        check_against_libjpeg(options);
+    }
+}
+
+static void test_quality(void){
+    encode_options_t options = QVGA_420;
+    const int qualities[] = { 5, 30, 63, 90, 100 };
+    for (int quality : qualities){
+        options.quality = quality;
+        check_against_libjpeg(options);
+    }
+}
+
+static void test_restart_intervals(void){
+    encode_options_t options = QVGA_420;
+    for (int rows = 1; rows <= 3; rows++){
+        options.restart_rows = rows;
+        check_against_libjpeg(options);
+    }
+}
+
+// A frame without tables decodes with the ones of the previous frame
+static void test_tables_reused(void){
+    encode_options_t options = QVGA_420;
+    check_against_libjpeg(options);
+    options.tables = false;
+    uint8_t *jpg;
+    unsigned long len;
+    encode(options, 1, &jpg, &len);
+    int width, height;
+    TEST_ASSERT_TRUE(jpeg_dc_thumbnail(&decoder, jpg, len, out, sizeof(out), &width, &height));
+    TEST_ASSERT_EQUAL_INT(40, width);
+    TEST_ASSERT_EQUAL_INT(30, height);
+
+    memset(&decoder, 0, sizeof(decoder));
+    TEST_ASSERT_FALSE(jpeg_dc_thumbnail(&decoder, jpg, len, out, sizeof(out), &width, &height));
+    free(jpg);
+}
+
+static void test_refused(void){
+    encode_options_t options = QVGA_420;
+    options.progressive = true;
+    uint8_t *jpg;
+    unsigned long len;
+    encode(options, 1, &jpg, &len);
+    int width, height;
+    TEST_ASSERT_FALSE(jpeg_dc_thumbnail(&decoder, jpg, len, out, sizeof(out), &width, &height));
+    free(jpg);
+
+    // Thumbnail larger than the output buffer
+    encode(QVGA_420, 1, &jpg, &len);
+    TEST_ASSERT_FALSE(jpeg_dc_thumbnail(&decoder, jpg, len, out, 40 * 30 - 1, &width, &height));
+    free(jpg);
+}
+
+// Truncated and corrupted frames, as a broken Wi-Fi link or a glitching sensor
+// delivers them: never a read outside the frame or a write outside out.
+// Worth running under the sanitizers: pio test -e native_asan
+static void test_corrupted(void){
+    uint8_t *jpg;
+    unsigned long len;
+    encode(QVGA_420, 7, &jpg, &len);
+    uint8_t *copy = (uint8_t *)malloc(len);
+    srand(1);
+    for (int i = 0; i < 20000; i++){
+        memcpy(copy, jpg, len);
+        size_t copy_len = len;
+        switch (i % 4){
+        case 0: // Truncated
+            copy_len = rand() % len;
+            break;
+        case 1: // Bit flips
+            for (int flips = 1 + rand() % 8; flips; flips--){
+                copy[rand() % len] ^= (uint8_t)(1 << (rand() % 8));
+            }
+            break;
+        case 2: // Random bytes, the headers included
+            for (int bytes = 1 + rand() % 8; bytes; bytes--){
+                copy[rand() % (len < 700 ? len : 700)] = (uint8_t)rand();
+            }
+            break;
+        default: // Random bytes anywhere, then truncated
+            for (int bytes = 1 + rand() % 32; bytes; bytes--){
+                copy[rand() % len] = (uint8_t)rand();
+            }
+            copy_len = len / 2 + rand() % (len / 2);
+            break;
+        }
+        // Exact size, an overrun reads past the heap block
+        uint8_t *frame = (uint8_t *)malloc(copy_len ? copy_len : 1);
+        memcpy(frame, copy, copy_len);
+        int width = 0, height = 0;
+        size_t out_size = 40 * 30;
+        if (jpeg_dc_thumbnail(&decoder, frame, copy_len, out, out_size, &width, &height)){
+            TEST_ASSERT_TRUE(width > 0 && height > 0);
+            TEST_ASSERT_TRUE((size_t)(width * height) <= out_size);
+        }
+        free(frame);
+    }
+    free(copy);
+    free(jpg);
+}
+
+int main(int argc, char **argv){
+    UNITY_BEGIN();
+    RUN_TEST(test_subsampling);
+    RUN_TEST(test_grayscale);
+    RUN_TEST(test_odd_sizes);
+    RUN_TEST(test_quality);
+    RUN_TEST(test_restart_intervals);
+    RUN_TEST(test_tables_reused);
+    RUN_TEST(test_refused);
+    RUN_TEST(test_corrupted);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+/*
+  ESP32CAM rcCar
+  Scene detector on frame sequences: sizes and 1/8 luma signatures as the
+  capture task sees them at 15 fps on a parked car, then motion.
+*/
+
+#include <unity.h>
+#include <scene_detector.h>
+#include <string.h>
+
+// Same settings as the capture task (frame_broadcaster.cpp)
+static const scene_config_t config = {
+    .size_threshold = 0.02f,
+    .signature_threshold = 4,
+    .idle_after_ms = 2000,
+    .keepalive_ms = 1000,
+};
+
+#define FRAME_MS 66     // 15 fps
+#define SIGNATURE_LEN 1200 // 40x30, QVGA
+
+static scene_state_t state;
+static uint8_t signature[SIGNATURE_LEN];
+static int64_t now_ms;
+
+// Parked car: JPEG size within 1% and sensor noise of +-2 on the thumbnail
+static void parked_frame(int i, size_t *len){
+    *len = 9000 + (i % 3) * 40;
+    for (int p = 0; p < SIGNATURE_LEN; p++){
+        signature[p] = (uint8_t)(100 + (p % 40) + ((p + i) % 5) - 2);
+    }
+}
+
+// Feed frames for duration_ms, returns the number sent and the largest gap between two sent frames
+static int feed_parked(int64_t duration_ms, int64_t *max_gap_ms){
+    int sent = 0;
+    int64_t last_sent = now_ms;
+    *max_gap_ms = 0;
+    for (int64_t end = now_ms + duration_ms; now_ms < end; now_ms += FRAME_MS){
+        size_t len;
+        parked_frame((int)(now_ms / FRAME_MS), &len);
+        if (scene_update(&config, &state, len, signature, SIGNATURE_LEN, now_ms)){
+            if (now_ms - last_sent > *max_gap_ms) *max_gap_ms = now_ms - last_sent;
+            last_sent = now_ms;
+            sent++;
+        }
+    }
+    return sent;
+}
+
+void setUp(void){
+    now_ms = 100000;
+    scene_reset(&state, now_ms);
+}
+
+void tearDown(void){
+}
+
+// Every frame goes out until the scene has been still for idle_after_ms
+void test_idle_entry(void){
+    int64_t gap;
+    int sent = feed_parked(1980, &gap);
+    TEST_ASSERT_EQUAL_INT(30, sent);
+    TEST_ASSERT_FALSE(state.idle);
+
+    feed_parked(FRAME_MS * 2, &gap);
+    TEST_ASSERT_TRUE(state.idle);
+}
+
+// While idle, one frame per keepalive_ms and never a longer gap
+void test_keepalive_spacing(void){
+    int64_t gap;
+    feed_parked(2100, &gap);
+    TEST_ASSERT_TRUE(state.idle);
+
+    int sent = feed_parked(10000, &gap);
+    TEST_ASSERT_TRUE(sent >= 9 && sent <= 10);
+    TEST_ASSERT_TRUE(gap >= config.keepalive_ms);
+    TEST_ASSERT_TRUE(gap < config.keepalive_ms + FRAME_MS);
+    TEST_ASSERT_TRUE(state.idle);
+}
+
+// A motor command re-arms at once: the next frame is sent, and every frame for idle_after_ms
+void test_rearm(void){
+    int64_t gap;
+    feed_parked(5000, &gap);
+    TEST_ASSERT_TRUE(state.idle);
+
+    scene_rearm(&state, now_ms);
+    TEST_ASSERT_FALSE(state.idle);
+    int sent = feed_parked(1980, &gap);
+    TEST_ASSERT_EQUAL_INT(30, sent);
+    TEST_ASSERT_EQUAL_INT(FRAME_MS, gap);
+}
+
+// A frame whose JPEG size jumps leaves idle
+void test_size_change(void){
+    int64_t gap;
+    feed_parked(5000, &gap);
+    TEST_ASSERT_TRUE(state.idle);
+
+    size_t len;
+    parked_frame(0, &len);
+    TEST_ASSERT_TRUE(scene_update(&config, &state, len * 11 / 10, signature, SIGNATURE_LEN, now_ms));
+    TEST_ASSERT_FALSE(state.idle);
+}
+
+// Same JPEG size but a different picture: the signature catches it
+void test_signature_change(void){
+    int64_t gap;
+    feed_parked(5000, &gap);
+    TEST_ASSERT_TRUE(state.idle);
+
+    size_t len;
+    parked_frame((int)(now_ms / FRAME_MS), &len);
+    for (int p = 0; p < SIGNATURE_LEN / 2; p++){
+        signature[p] += 20; // Something moved into the left half
+    }
+    TEST_ASSERT_TRUE(scene_update(&config, &state, len, signature, SIGNATURE_LEN, now_ms));
+    TEST_ASSERT_FALSE(state.idle);
+}
+
+// Without signatures (frames above QVGA) the size alone decides
+void test_size_only(void){
+    for (int i = 0; i < 40; i++, now_ms += FRAME_MS){
+        scene_update(&config, &state, 20000 + (i % 2) * 100, NULL, 0, now_ms);
+    }
+    TEST_ASSERT_TRUE(state.idle);
+    TEST_ASSERT_TRUE(scene_update(&config, &state, 23000, NULL, 0, now_ms));
+    TEST_ASSERT_FALSE(state.idle);
+}
+
+int main(int argc, char **argv){
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_entry);
+    RUN_TEST(test_keepalive_spacing);
+    RUN_TEST(test_rearm);
+    RUN_TEST(test_size_change);
+    RUN_TEST(test_signature_change);
+    RUN_TEST(test_size_only);
+    return UNITY_END();
+}
@@ -0,0 +1,137 @@
+/*
+  ESP32CAM rcCar
+  Slew limiter on the motor task's tick, and the current it saves: a small
+  brushed motor simulated between ticks (4 V, 2 ohm, no inductance).
+*/
+
+#include <unity.h>
+#include <slew_limiter.h>
+#include <math.h>
+#include <stdio.h>
+
+// Same settings as the motor task (user_define.h)
+#define TICK_HZ 200 // MOTOR_CONTROL_HZ
+static const slew_limits_t limits = { 500, 1000, 400 }; // MOTOR_ACCEL, MOTOR_BRAKE, MOTOR_REVERSE
+
+// Average model of the motor, the duty scales the supply
+#define SUPPLY_V 4.0
+#define WINDING_OHM 2.0
+#define MOTOR_K 0.004     // Back-EMF V per rad/s, and torque N.m per A
+#define INERTIA 2e-6      // kg.m^2, rotor and gearbox
+#define FRICTION 1e-6     // N.m per rad/s
+#define SUBSTEPS 100      // Integration steps per tick
+
+static slew_state_t state;
+static double speed;      // rad/s
+
+// Run ticks toward target, with or without the limiter. Returns the peak current in A
+static double drive(int target, int ticks, bool limited){
+    double peak = 0;
+    const double dt = 1.0 / TICK_HZ / SUBSTEPS;
+    for (int t = 0; t < ticks; t++){
+        int duty = limited ? slew_step(&state, target) : target;
+        for (int s = 0; s < SUBSTEPS; s++){
+            double current = (duty / 100.0 * SUPPLY_V - MOTOR_K * speed) / WINDING_OHM;
+            peak = fmax(peak, fabs(current));
+            speed += dt * (MOTOR_K * current - FRICTION * speed) / INERTIA;
+        }
+    }
+    return peak;
+}
+
+// Ticks until the duty reaches target
+static int ticks_to(int target, int limit_ticks){
+    for (int t = 1; t <= limit_ticks; t++){
+        if (slew_step(&state, target) == target){
+            return t;
+        }
+    }
+    return -1;
+}
+
+void setUp(void){
+    slew_init(&state, &limits, TICK_HZ);
+    speed = 0;
+}
+
+void tearDown(void){}
+
+static void test_accel(void){
+    TEST_ASSERT_EQUAL_INT(40, ticks_to(100, 1000)); // 500 %/s, 200 ms
+}
+
+static void test_brake(void){
+    slew_reset(&state, 100);
+    TEST_ASSERT_EQUAL_INT(20, ticks_to(0, 1000)); // 1000 %/s, 100 ms
+    slew_reset(&state, -100);
+    TEST_ASSERT_EQUAL_INT(10, ticks_to(-50, 1000));
+}
+
+// A flick goes down to 0 at the reverse limit, then up at the accel limit
+static void test_reversal(void){
+    slew_reset(&state, 100);
+    int ticks = 0;
+    int duty = 100;
+    while (duty > 0 && ticks < 1000){
+        duty = slew_step(&state, -100);
+        ticks++;
+    }
+    TEST_ASSERT_EQUAL_INT(50, ticks); // 400 %/s, 250 ms
+    TEST_ASSERT_EQUAL_INT(40, ticks_to(-100, 1000)); // 450 ms in all
+}
+
+// Slow limits still move, at least 1/256 of a duty per tick
+static void test_slow_limit(void){
+    slew_limits_t slow = { 1, 1, 1 };
+    slew_init(&state, &slow, TICK_HZ);
+    TEST_ASSERT_EQUAL_INT(128, ticks_to(1, 1000)); // Rounded up at half a duty
+}
+
+static void test_reset_and_no_limit(void){
+    slew_reset(&state, -70);
+    TEST_ASSERT_EQUAL_INT(-70, slew_step(&state, -70));
+    slew_limits_t none = { 0, 0, 0 };
+    slew_init(&state, &none, TICK_HZ);
+    TEST_ASSERT_EQUAL_INT(100, slew_step(&state, 100));
+    TEST_ASSERT_EQUAL_INT(0, slew_step(&state, -100)); // The H-bridge still flips at 0, for one tick
+    TEST_ASSERT_EQUAL_INT(-100, slew_step(&state, -100));
+}
+
+// Standing start to full throttle: the stalled motor draws the whole supply current
+static void test_peak_current_start(void){
+    double unlimited = drive(100, 2 * TICK_HZ, false);
+    speed = 0;
+    double limited = drive(100, 2 * TICK_HZ, true);
+    char message[64];
+    snprintf(message, sizeof(message), "0 to 100: %.2f A unlimited, %.2f A limited", unlimited, limited);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 2.00, unlimited);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1.40, limited);
+}
+
+// Full forward to full reverse: the back-EMF adds to the supply
+static void test_peak_current_flick(void){
+    drive(100, 2 * TICK_HZ, false); // Up to speed
+    double unlimited = drive(-100, 2 * TICK_HZ, false);
+
+    setUp();
+    drive(100, 2 * TICK_HZ, true);
+    double limited = drive(-100, 2 * TICK_HZ, true);
+    char message[64];
+    snprintf(message, sizeof(message), "100 to -100: %.2f A unlimited, %.2f A limited", unlimited, limited);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 3.78, unlimited);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1.84, limited);
+}
+
+int main(int argc, char **argv){
+    UNITY_BEGIN();
+    RUN_TEST(test_accel);
+    RUN_TEST(test_brake);
+    RUN_TEST(test_reversal);
+    RUN_TEST(test_slow_limit);
+    RUN_TEST(test_reset_and_no_limit);
+    RUN_TEST(test_peak_current_start);
+    RUN_TEST(test_peak_current_flick);
+    return UNITY_END();
+}
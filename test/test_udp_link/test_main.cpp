@@ -0,0 +1,201 @@
+/*
+  ESP32CAM rcCar
+  UDP control acceptance over 127.0.0.1: the reference client (tools/udp_client.h)
+  against the car's rules (udp_link), with the device side played by the test.
+*/
+
+#include <unity.h>
+#include <udp_link.h>
+#include "udp_client.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string.h>
+
+#define MAX_AGE_MS 200      // UDP_MAX_AGE_MS
+#define DEVICE_CLOCK 500000 // Device clock ahead of the host, as after a few minutes of uptime
+
+static int device_sock = -1;
+static struct sockaddr_in device_addr;
+static udp_link_t link_state;
+static int32_t device_skew_ms; // Added to the device clock, to make packets late
+
+static uint32_t device_ms(){
+    return local_ms() + DEVICE_CLOCK + device_skew_ms;
+}
+
+static Client connect_client(){
+    Client client;
+    client.sock = socket(AF_INET, SOCK_DGRAM, 0);
+    TEST_ASSERT_TRUE(client.sock >= 0);
+    TEST_ASSERT_EQUAL_INT(0, connect(client.sock, (struct sockaddr *)&device_addr, sizeof(device_addr)));
+    return client;
+}
+
+// One datagram through the car's rules, answered with a telemetry reply when accepted
+static udp_link_verdict_t device_receive(){
+    uint8_t packet[64];
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+    int len = recvfrom(device_sock, packet, sizeof(packet), 0, (struct sockaddr *)&from, &from_len);
+    TEST_ASSERT_TRUE(len >= 0);
+    udp_link_verdict_t verdict = udp_link_check(&link_state, packet, len, from.sin_addr.s_addr, from.sin_port, device_ms());
+    if (verdict == UDP_LINK_ACCEPT || verdict == UDP_LINK_NEW_PEER){
+        udp_cmd_t cmd;
+        memcpy(&cmd, packet, sizeof(cmd));
+        udp_telemetry_t reply;
+        memset(&reply, 0, sizeof(reply));
+        reply.magic = UDP_TELEMETRY_MAGIC;
+        reply.flags = cmd.flags;
+        reply.seq = cmd.seq;
+        reply.client_ms = cmd.client_ms;
+        reply.device_ms = device_ms();
+        reply.duty_right = cmd.x;
+        reply.duty_left = cmd.y;
+        reply.dropped = link_state.dropped;
+        sendto(device_sock, &reply, sizeof(reply), 0, (struct sockaddr *)&from, from_len);
+    }
+    return verdict;
+}
+
+// Client sends, the device checks it, the client reads the reply if any
+static udp_link_verdict_t drive(Client &client, int x, int y, uint8_t flags = 0){
+    client.send(x, y, flags);
+    udp_link_verdict_t verdict = device_receive();
+    client.receive(local_ms() + 20);
+    return verdict;
+}
+
+// A datagram the client did not make
+static udp_link_verdict_t send_raw(Client &client, const void *packet, size_t len){
+    TEST_ASSERT_EQUAL_INT((int)len, (int)::send(client.sock, packet, len, 0));
+    return device_receive();
+}
+
+void setUp(void){
+    device_sock = socket(AF_INET, SOCK_DGRAM, 0);
+    memset(&device_addr, 0, sizeof(device_addr));
+    device_addr.sin_family = AF_INET;
+    device_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    device_addr.sin_port = 0; // Any free port
+    TEST_ASSERT_EQUAL_INT(0, bind(device_sock, (struct sockaddr *)&device_addr, sizeof(device_addr)));
+    socklen_t addr_len = sizeof(device_addr);
+    getsockname(device_sock, (struct sockaddr *)&device_addr, &addr_len);
+    struct timeval timeout = { 1, 0 }; // A lost datagram fails the test instead of hanging it
+    setsockopt(device_sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    udp_link_init(&link_state, MAX_AGE_MS);
+    device_skew_ms = 0;
+}
+
+void tearDown(void){
+    close(device_sock);
+}
+
+static void test_sequence(void){
+    Client client = connect_client();
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_NEW_PEER, drive(client, 10, 50));
+    for (int i = 0; i < 5; i++){
+        TEST_ASSERT_EQUAL_INT(UDP_LINK_ACCEPT, drive(client, 10, 50 + i));
+    }
+    TEST_ASSERT_EQUAL_INT(6, client.acked);
+    TEST_ASSERT_EQUAL_INT(54, client.last.duty_left);
+
+    // Replayed and reordered packets from the same sender
+    udp_cmd_t cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.magic = UDP_CMD_MAGIC;
+    cmd.seq = client.seq;
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_OLD, send_raw(client, &cmd, sizeof(cmd)));
+    cmd.seq = client.seq - 3;
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_OLD, send_raw(client, &cmd, sizeof(cmd)));
+
+    // The next one goes through and reports the two drops
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_ACCEPT, drive(client, 0, 0));
+    TEST_ASSERT_EQUAL_INT(2, client.last.dropped);
+    close(client.sock);
+}
+
+static void test_sequence_wraps(void){
+    Client client = connect_client();
+    client.seq = UINT32_MAX - 2;
+    for (int i = 0; i < 5; i++){
+        TEST_ASSERT_TRUE(drive(client, 0, 20) != UDP_LINK_OLD);
+    }
+    TEST_ASSERT_EQUAL_INT(2, (int)client.seq);
+    TEST_ASSERT_EQUAL_INT(0, link_state.dropped);
+    close(client.sock);
+}
+
+static void test_malformed(void){
+    Client client = connect_client();
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_NEW_PEER, drive(client, 0, 0));
+    udp_cmd_t cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.magic = UDP_CMD_MAGIC;
+    cmd.seq = 100;
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_MALFORMED, send_raw(client, &cmd, sizeof(cmd) - 1));
+    cmd.magic = UDP_TELEMETRY_MAGIC;
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_MALFORMED, send_raw(client, &cmd, sizeof(cmd)));
+    TEST_ASSERT_EQUAL_INT(2, link_state.dropped);
+    // Refused packets don't move the sequence
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_ACCEPT, drive(client, 0, 0));
+    close(client.sock);
+}
+
+// Once synced from the replies, packets held up longer than MAX_AGE_MS are dropped
+static void test_stale(void){
+    Client client = connect_client();
+    for (int i = 0; i < 3; i++){
+        drive(client, 0, 30);
+    }
+    TEST_ASSERT_TRUE(client.synced);
+    int32_t expected_offset = DEVICE_CLOCK;
+    TEST_ASSERT_TRUE(client.offset_ms >= expected_offset - 5 && client.offset_ms <= expected_offset + 5);
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_ACCEPT, drive(client, 0, 30));
+
+    device_skew_ms = MAX_AGE_MS + 50; // As if it took that long to arrive
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_STALE, drive(client, 0, 30));
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_STALE, drive(client, 0, 30));
+    device_skew_ms = MAX_AGE_MS - 50;
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_ACCEPT, drive(client, 0, 30));
+    TEST_ASSERT_EQUAL_INT(2, client.last.dropped);
+
+    // Unsynced packets have no comparable timestamp and are never stale
+    Client fresh = connect_client();
+    device_skew_ms = 100000;
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_NEW_PEER, drive(fresh, 0, 0));
+    close(fresh.sock);
+    close(client.sock);
+}
+
+// A second sender takes over with its own sequence, and the first can take it back
+static void test_peer_takeover(void){
+    Client first = connect_client();
+    for (int i = 0; i < 10; i++){
+        drive(first, 40, 40);
+    }
+    TEST_ASSERT_EQUAL_INT(10, (int)link_state.last_seq);
+
+    Client second = connect_client();
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_NEW_PEER, drive(second, -40, 0)); // seq 1, below the first one's
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_ACCEPT, drive(second, -40, 0));
+    TEST_ASSERT_EQUAL_INT(-40, second.last.duty_right);
+
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_NEW_PEER, drive(first, 0, 0));
+    TEST_ASSERT_EQUAL_INT(UDP_LINK_NEW_PEER, drive(second, 0, 0)); // Back and forth, never dropped
+    TEST_ASSERT_EQUAL_INT(0, link_state.dropped);
+    close(second.sock);
+    close(first.sock);
+}
+
+int main(int argc, char **argv){
+    UNITY_BEGIN();
+    RUN_TEST(test_sequence);
+    RUN_TEST(test_sequence_wraps);
+    RUN_TEST(test_malformed);
+    RUN_TEST(test_stale);
+    RUN_TEST(test_peer_takeover);
+    return UNITY_END();
+}
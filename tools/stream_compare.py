@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""
+ESP32CAM rcCar
+Compare the raw and chunked stream framings on the car (/control?var=stream_raw)
+
+Usage: python3 tools/stream_compare.py [host] [seconds]
+
+Connected to the car's access point, each framing is streamed from :81/stream
+for the given time (20 s by default) and the bytes per second, frames per
+second and mean frame interval are printed side by side. The framing is
+restored to raw at the end. The car also logs "Stream <fd> (raw|chunked)"
+every 5 s on the serial port for the same connection.
+"""
+
+import http.client
+import sys
+import time
+import urllib.request
+
+BOUNDARY = b"\r\n--123456789000000000000987654321\r\n"  # PART_BOUNDARY, app_httpd.cpp
+
+
+def set_raw(host, raw):
+    url = "http://%s/control?var=stream_raw&val=%d" % (host, 1 if raw else 0)
+    urllib.request.urlopen(url, timeout=5).read()
+
+
+def measure(host, seconds):
+    conn = http.client.HTTPConnection(host, 81, timeout=5)
+    conn.request("GET", "/stream")
+    resp = conn.getresponse()
+    if resp.status != 200:
+        raise RuntimeError("stream answered %d" % resp.status)
+
+    received = 0
+    frames = 0
+    tail = b""
+    start = time.monotonic()
+    while time.monotonic() - start < seconds:
+        data = resp.read1(65536)  # Undoes the chunked encoding, if any
+        if not data:
+            break
+        received += len(data)
+        # Boundaries can straddle reads, keep the end of the previous one
+        buf = tail + data
+        frames += buf.count(BOUNDARY)
+        tail = buf[-(len(BOUNDARY) - 1):]
+    elapsed = time.monotonic() - start
+    conn.close()
+    return received / elapsed, frames / elapsed
+
+
+def main():
+    host = sys.argv[1] if len(sys.argv) > 1 else "192.168.4.1"  # Soft AP address
+    seconds = float(sys.argv[2]) if len(sys.argv) > 2 else 20.0
+
+    results = {}
+    for raw in (False, True):
+        set_raw(host, raw)  # Applies to the next connection
+        time.sleep(1)
+        results[raw] = measure(host, seconds)
+    set_raw(host, True)
+
+    print("%-8s %12s %8s %12s" % ("framing", "bytes/s", "fps", "interval ms"))
+    for raw in (False, True):
+        bps, fps = results[raw]
+        print("%-8s %12.0f %8.1f %12.1f" % ("raw" if raw else "chunked", bps, fps, 1000 / fps if fps else 0))
+    chunked, raw = results[False], results[True]
+    if chunked[1]:
+        print("raw vs chunked: %+.1f%% fps, %+.1f%% bytes/s"
+              % ((raw[1] / chunked[1] - 1) * 100, (raw[0] / chunked[0] - 1) * 100))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,92 @@
+#ifndef UDP_CLIENT_H
+#define UDP_CLIENT_H
+
+// Client side of the UDP control port (include/control_protocol.h), Linux.
+// Used by tools/udp_drive.cpp and the loopback test (test/test_udp_link).
+
+#include "control_protocol.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+static inline uint32_t local_ms() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct Client {
+    int sock = -1;
+    uint32_t seq = 0;
+    // Device clock estimate, kept from the reply with the fastest round trip
+    bool synced = false;
+    int32_t offset_ms = 0;
+    uint32_t best_rtt = UINT32_MAX;
+    // Statistics since the last report
+    uint32_t sent = 0, acked = 0, rtt_sum = 0, rtt_max = 0;
+    udp_telemetry_t last = {};
+
+    void send(int x, int y, uint8_t flags) {
+        udp_cmd_t cmd = {};
+        cmd.magic = UDP_CMD_MAGIC;
+        cmd.x = (int8_t)x;
+        cmd.y = (int8_t)y;
+        cmd.seq = ++seq;
+        cmd.flags = flags;
+        cmd.client_ms = local_ms();
+        if (synced) {
+            cmd.flags |= UDP_FLAG_SYNCED;
+            cmd.client_ms += offset_ms;
+        }
+        if (::send(sock, &cmd, sizeof(cmd), 0) == sizeof(cmd)) {
+            sent++;
+        }
+    }
+
+    // Read the replies until the deadline
+    void receive(uint32_t until_ms) {
+        for (;;) {
+            int32_t wait = (int32_t)(until_ms - local_ms());
+            if (wait < 0) {
+                wait = 0;
+            }
+            struct pollfd pfd = { sock, POLLIN, 0 };
+            if (poll(&pfd, 1, wait) <= 0) {
+                return;
+            }
+            udp_telemetry_t reply;
+            if (recv(sock, &reply, sizeof(reply), 0) != sizeof(reply) || reply.magic != UDP_TELEMETRY_MAGIC) {
+                continue;
+            }
+            uint32_t now = local_ms();
+            uint32_t sent_ms = reply.client_ms - ((reply.flags & UDP_FLAG_SYNCED) ? offset_ms : 0);
+            uint32_t rtt = now - sent_ms;
+            // NTP-like: the device applied the command half a round trip after it was sent
+            if (rtt <= best_rtt) {
+                best_rtt = rtt;
+                offset_ms = (int32_t)(reply.device_ms - (sent_ms + rtt / 2));
+                synced = true;
+            }
+            best_rtt += best_rtt / 64 + 1; // Let the best round trip age out to follow clock drift
+            acked++;
+            rtt_sum += rtt;
+            if (rtt > rtt_max) {
+                rtt_max = rtt;
+            }
+            last = reply;
+        }
+    }
+
+    void report() {
+        printf("sent %u acked %u rtt avg %u max %u ms | duty R %d L %d | battery %u%% | fps %.1f | dropped %u\n",
+               sent, acked, acked ? rtt_sum / acked : 0, rtt_max, last.duty_right, last.duty_left,
+               last.battery, last.fps_x10 / 10.0, last.dropped);
+        fflush(stdout);
+        sent = acked = rtt_sum = rtt_max = 0;
+    }
+};
+
+#endif // UDP_CLIENT_H
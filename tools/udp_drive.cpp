@@ -0,0 +1,85 @@
+/*
+  ESP32CAM rcCar
+  Reference client for the UDP control port (include/control_protocol.h), Linux
+
+  Build: pio run -e udp_drive, the binary is .pio/build/udp_drive/program
+     or: g++ -std=c++11 -O2 -Iinclude -Itools -o udp_drive tools/udp_drive.cpp
+  Usage: udp_drive [host] [port] [rate_hz] < script
+
+  The script has one command per line, "x y duration_ms", x and y in -100..100.
+  Lines starting with # are ignored. The current command is sent rate_hz times
+  per second so a lost packet is replaced by the next one, it also keeps the
+  car's dead-man timer (MOTOR_TIMEOUT_MS) from stopping it: rate_hz must stay
+  well above 1000 / MOTOR_TIMEOUT_MS. The car is stopped at the end of the
+  script. One line of telemetry is printed per second.
+*/
+
+#include "udp_client.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+int main(int argc, char **argv) {
+    const char *host = argc > 1 ? argv[1] : "192.168.4.1"; // Soft AP address
+    int port = argc > 2 ? atoi(argv[2]) : 4210;            // UDP_CONTROL_PORT
+    int rate_hz = argc > 3 ? atoi(argv[3]) : 50;
+    if (rate_hz < 1 || rate_hz > 1000) {
+        fprintf(stderr, "rate_hz must be 1..1000\n");
+        return 1;
+    }
+
+    Client client;
+    client.sock = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (client.sock < 0 || inet_pton(AF_INET, host, &addr.sin_addr) != 1 ||
+        connect(client.sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        fprintf(stderr, "Can't reach %s:%d\n", host, port);
+        return 1;
+    }
+
+    uint32_t period = 1000 / rate_hz;
+    uint32_t next_report = local_ms() + 1000;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        int x, y, duration;
+        std::istringstream fields(line);
+        if (!(fields >> x >> y >> duration)) {
+            fprintf(stderr, "Skipped \"%s\", expected: x y duration_ms\n", line.c_str());
+            continue;
+        }
+        uint32_t end = local_ms() + duration;
+        uint32_t next = local_ms();
+        while ((int32_t)(end - next) > 0) {
+            client.send(x, y, 0);
+            next += period;
+            client.receive(next);
+            if ((int32_t)(local_ms() - next_report) >= 0) {
+                client.report();
+                next_report += 1000;
+            }
+        }
+    }
+
+    // Make sure the stop gets through
+    for (int i = 0; i < 3; i++) {
+        client.send(0, 0, UDP_FLAG_STOP);
+        client.receive(local_ms() + period);
+    }
+    client.report();
+    close(client.sock);
+    return 0;
+}